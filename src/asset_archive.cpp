@@ -0,0 +1,186 @@
+#include "asset_archive.h"
+#include <cstring>
+#include <iostream>
+
+#include <sys/stat.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+/**
+ * read_u32
+ * \param pData : Archive bytes
+ * \brief Read a little-endian 32 bits value
+ * \return Uint32 : value
+ **/
+static Uint32 read_u32(const Uint8* pData)
+{
+	return (Uint32)pData[0] | ((Uint32)pData[1] << 8) | ((Uint32)pData[2] << 16) | ((Uint32)pData[3] << 24);
+}
+
+/**
+ * hash
+ * \param pPath : Relative path
+ * \brief Hash of a relative path (FNV-1a, 32 bits)
+ * \return Uint32 : hash
+ **/
+Uint32 AssetArchive::hash(std::string pPath)
+{
+	Uint32 lHash = 2166136261u;
+	for(auto lChar : pPath)
+	{
+		lHash ^= (Uint8)lChar;
+		lHash *= 16777619u;
+	}
+	return lHash;
+}
+
+/**
+ * mount
+ * \param pRootPath : Game base path
+ * \param pArchiveName : Archive file name (in the base path)
+ * \brief Map the archive in memory
+ * \return boolean : archive mapped status
+ **/
+bool AssetArchive::mount(std::string pRootPath, std::string pArchiveName)
+{
+	unmount();
+	root_path = pRootPath;
+
+	std::string lPath = root_path + pArchiveName;
+
+#ifdef _WIN32
+	struct stat lStat;
+	if(stat(lPath.c_str(), &lStat) < 0)
+	{
+		return false;
+	}
+
+	size_t lSize{0};
+	void* lData = SDL_LoadFile(lPath.c_str(), &lSize);
+	if(lData == nullptr)
+	{
+		return false;
+	}
+#else
+	int lFile = ::open(lPath.c_str(), O_RDONLY);
+	if(lFile < 0)
+	{
+		return false;
+	}
+
+	struct stat lStat;
+	if(fstat(lFile, &lStat) < 0 || lStat.st_size < (off_t)HEADER_SIZE)
+	{
+		::close(lFile);
+		return false;
+	}
+
+	size_t lSize = lStat.st_size;
+	void* lData = mmap(nullptr, lSize, PROT_READ, MAP_PRIVATE, lFile, 0);
+	::close(lFile);
+	if(lData == MAP_FAILED)
+	{
+		return false;
+	}
+
+	//The whole archive is read sequentially at startup
+	madvise(lData, lSize, MADV_WILLNEED);
+#endif
+
+	data = (const Uint8*)lData;
+	data_size = lSize;
+	stamp = lStat.st_mtime;
+
+	if(data_size < HEADER_SIZE || memcmp(data, "EPAK", 4) != 0 || read_u32(data + 4) != VERSION)
+	{
+		std::cerr << "Invalid asset archive: " + lPath << std::endl;
+		unmount();
+		return false;
+	}
+
+	slot_count = read_u32(data + 12);
+	if(slot_count == 0 || (slot_count & (slot_count - 1)) != 0 || HEADER_SIZE + (size_t)slot_count * SLOT_SIZE > data_size)
+	{
+		std::cerr << "Invalid asset archive directory: " + lPath << std::endl;
+		unmount();
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * unmount
+ * \brief Unmap the archive
+ * \return void
+ **/
+void AssetArchive::unmount()
+{
+	if(data != nullptr)
+	{
+#ifdef _WIN32
+		SDL_free((void*)data);
+#else
+		munmap((void*)data, data_size);
+#endif
+	}
+
+	data = nullptr;
+	data_size = 0;
+	slot_count = 0;
+	stamp = 0;
+}
+
+/**
+ * find
+ * \param pPath : Relative path
+ * \param pOffset : File offset in the archive (output)
+ * \param pSize : File size (output)
+ * \brief Find a file in the archive directory (open addressing)
+ * \return boolean : found status
+ **/
+bool AssetArchive::find(std::string pPath, Uint32* pOffset, Uint32* pSize)
+{
+	if(data == nullptr)
+	{
+		return false;
+	}
+
+	Uint32 lHash = hash(pPath);
+	for(Uint32 lProbe = 0; lProbe < slot_count; lProbe++)
+	{
+		const Uint8* lSlot = data + HEADER_SIZE + ((lHash + lProbe) & (slot_count - 1)) * SLOT_SIZE;
+
+		Uint32 lNameOffset = read_u32(lSlot + 4);
+		if(lNameOffset == 0)
+		{
+			//Empty slot : not in the archive
+			return false;
+		}
+
+		if(read_u32(lSlot) == lHash && lNameOffset < data_size &&
+			strncmp((const char*)data + lNameOffset, pPath.c_str(), data_size - lNameOffset) == 0)
+		{
+			*pOffset = read_u32(lSlot + 8);
+			*pSize = read_u32(lSlot + 12);
+			return (size_t)*pOffset + *pSize <= data_size;
+		}
+	}
+	return false;
+}
+
+/**
+ * open
+ * \param pOffset : File offset in the archive
+ * \param pSize : File size
+ * \brief Open an archived file for reading (from the archive memory)
+ * \return SDL_RWops* : file stream
+ **/
+SDL_RWops* AssetArchive::open(Uint32 pOffset, Uint32 pSize)
+{
+	return SDL_RWFromConstMem(data + pOffset, pSize);
+}
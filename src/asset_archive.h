@@ -0,0 +1,73 @@
+#ifndef ASSET_ARCHIVE_H
+#define ASSET_ARCHIVE_H
+
+#include <string>
+#include <SDL2/SDL.h>
+
+/**
+ * \class AssetArchive
+ * \brief Memory-mapped game files archive (eraser.pak: hashed directory
+ *        of every file under assets/ and data/), mounted through Vfs
+ *
+ * Archive layout (little-endian 32 bits values):
+ *  - header : "EPAK", version, entry count, slot count (power of 2)
+ *  - slots  : hash (FNV-1a of the relative path), name offset,
+ *             data offset, data size (name offset 0 means empty slot)
+ *  - names  : '\0' terminated relative paths
+ *  - data   : file contents
+ **/
+class AssetArchive
+{
+	private:
+		std::string root_path;
+
+		const Uint8* data;
+		size_t data_size;
+		Uint32 slot_count;
+
+		//Modification time of the archive file
+		Uint64 stamp;
+
+	public:
+		static const Uint32 VERSION = 1;
+		static const Uint32 HEADER_SIZE = 16;
+		static const Uint32 SLOT_SIZE = 16;
+
+		//Constructor
+		AssetArchive()
+		{
+			data = nullptr;
+			data_size = 0;
+			slot_count = 0;
+			stamp = 0;
+		}
+
+		//Hash of a relative path (FNV-1a)
+		static Uint32 hash(std::string pPath);
+
+		//Map the archive of the root path
+		bool mount(std::string pRootPath, std::string pArchiveName);
+
+		//Unmap the archive
+		void unmount();
+
+		//Check if the archive is mapped
+		bool is_mounted(){return data != nullptr;}
+
+		//Getter for the root path (loose files directory)
+		std::string get_root_path(){return root_path;}
+
+		//Getter for the modification time of the archive file
+		Uint64 get_stamp(){return stamp;}
+
+		//Find a file (relative path) in the archive directory
+		bool find(std::string pPath, Uint32* pOffset, Uint32* pSize);
+
+		//Open an archived file for reading
+		SDL_RWops* open(Uint32 pOffset, Uint32 pSize);
+
+		//Getter for the mapped bytes of an archived file
+		const Uint8* get_data(Uint32 pOffset){return data + pOffset;}
+};
+
+#endif
@@ -0,0 +1,124 @@
+#include "audio_bank.h"
+#include <iostream>
+
+/**
+ * load_music
+ * \param pId : Music file
+ * \brief Open the music (streamed, decoded while it is played)
+ * \return boolean : load music status
+ **/
+bool AudioBank::load_music(AssetId pId)
+{
+	if(music != nullptr)
+	{
+		return true;
+	}
+
+	music = Mix_LoadMUS_RW(vfs->open(pId), 1);
+	if(music == nullptr)
+	{
+		std::cerr << "Cannot load music: " + vfs->get_name(pId) << std::endl;
+		return false;
+	}
+	return true;
+}
+
+/**
+ * load_chunk
+ * \param pId : Sound file
+ * \param pVolume : Sound volume (0 to MIX_MAX_VOLUME)
+ * \brief Load a sound once, converted to the format of the opened audio device
+ * \return boolean : load sound status
+ **/
+bool AudioBank::load_chunk(AssetId pId, int pVolume)
+{
+	if(chunks.count(pId) > 0)
+	{
+		return true;
+	}
+
+	Mix_Chunk* lChunk = Mix_LoadWAV_RW(vfs->open(pId), 1);
+	if(lChunk == nullptr)
+	{
+		std::cerr << "Cannot load sound: " + vfs->get_name(pId) << std::endl;
+		return false;
+	}
+	Mix_VolumeChunk(lChunk, pVolume);
+
+	chunks[pId] = lChunk;
+	return true;
+}
+
+/**
+ * get_chunk
+ * \param pId : Sound file
+ * \brief Getter for a loaded sound
+ * \return Mix_Chunk* : sound (nullptr if not loaded)
+ **/
+Mix_Chunk* AudioBank::get_chunk(AssetId pId)
+{
+	auto lIt = chunks.find(pId);
+	if(lIt == chunks.end())
+	{
+		return nullptr;
+	}
+	return lIt->second;
+}
+
+/**
+ * play_sound
+ * \param pId : Sound file
+ * \brief Play a loaded sound once on the first free channel
+ * \return void
+ **/
+void AudioBank::play_sound(AssetId pId)
+{
+	Mix_Chunk* lChunk = get_chunk(pId);
+	if(lChunk != nullptr)
+	{
+		Mix_PlayChannel(-1, lChunk, 0);
+	}
+}
+
+/**
+ * play_music
+ * \param pVolume : Music volume (0 to MIX_MAX_VOLUME)
+ * \brief Play the music in loop, it is not restarted if it is already playing
+ * \return void
+ **/
+void AudioBank::play_music(int pVolume)
+{
+	if(!Mix_PlayingMusic())
+	{
+		Mix_PlayMusic(music, -1);
+	}
+	Mix_VolumeMusic(pVolume);
+}
+
+/**
+ * stop_music
+ * \brief Stop the music
+ * \return void
+ **/
+void AudioBank::stop_music()
+{
+	Mix_HaltMusic();
+}
+
+/**
+ * clear
+ * \brief Free the music and the sounds
+ * \return void
+ **/
+void AudioBank::clear()
+{
+	Mix_HaltMusic();
+	Mix_FreeMusic(music);
+	music = nullptr;
+
+	for(auto &lChunk : chunks)
+	{
+		Mix_FreeChunk(lChunk.second);
+	}
+	chunks.clear();
+}
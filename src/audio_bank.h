@@ -0,0 +1,58 @@
+#ifndef AUDIO_BANK_H
+#define AUDIO_BANK_H
+
+#include <unordered_map>
+#include <SDL2/SDL.h>
+#include "vfs.h"
+#include "game_audio.h"
+
+#ifdef __APPLE__
+#include <SDL2_mixer/SDL_mixer.h>
+#else
+#include <SDL2/SDL_mixer.h>
+#endif
+
+/**
+ * \class AudioBank
+ * \brief Music and sounds loaded once for the whole game
+ *        (the music keeps streaming across levels)
+ **/
+class AudioBank : public GameAudio
+{
+	private:
+		Vfs* vfs;
+
+		Mix_Music* music;
+		std::unordered_map<AssetId, Mix_Chunk*> chunks;
+
+	public:
+		//Constructor
+		AudioBank(Vfs* pVfs=nullptr)
+		{
+			vfs = pVfs;
+			music = nullptr;
+		}
+
+		//Open the streamed music
+		bool load_music(AssetId pId);
+
+		//Load a sound (converted to the opened device format)
+		bool load_chunk(AssetId pId, int pVolume);
+
+		//Getter for a loaded sound
+		Mix_Chunk* get_chunk(AssetId pId);
+
+		//Play a loaded sound once
+		void play_sound(AssetId pId) override;
+
+		//Play the music (keeps playing if it already is)
+		void play_music(int pVolume) override;
+
+		//Stop the music
+		void stop_music() override;
+
+		//Free the music and the sounds
+		void clear();
+};
+
+#endif
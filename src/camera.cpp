@@ -0,0 +1,86 @@
+#include "camera.h"
+
+/**
+ * set_bounds
+ * \param pBounds : Map area (pixels)
+ * \brief Set the map area and move the view back inside it
+ * \return void
+ **/
+void Camera::set_bounds(const SDL_Rect& pBounds)
+{
+	bounds = pBounds;
+	follow({view.x + view.w / 2, view.y + view.h / 2, 0, 0});
+}
+
+/**
+ * follow
+ * \param pRect : Area of the map to show (the player)
+ * \brief Center the view on an area, kept inside the map (a map smaller than
+ *        the screen stays at its top left corner)
+ * \return void
+ **/
+void Camera::follow(const SDL_Rect& pRect)
+{
+	view.x = pRect.x + pRect.w / 2 - view.w / 2;
+	view.y = pRect.y + pRect.h / 2 - view.h / 2;
+
+	view.x = SDL_max(bounds.x, SDL_min(view.x, bounds.x + bounds.w - view.w));
+	view.y = SDL_max(bounds.y, SDL_min(view.y, bounds.y + bounds.h - view.h));
+}
+
+/**
+ * push
+ * \param pLayer : Layer (GameRenderer::LAYER_*)
+ * \param pTexture : Sprite texture
+ * \param pSrc : Area of the texture
+ * \param pDst : Area of the map
+ * \param pIsFlipped : Mirror the sprite horizontally
+ * \param pColor : Tint (white to keep the texture colors)
+ * \brief Send a sprite on screen to the frame renderer, drop it otherwise
+ * \return void
+ **/
+void Camera::push(int pLayer, SDL_Texture* pTexture, const SDL_Rect& pSrc, const SDL_Rect& pDst, bool pIsFlipped, SDL_Color pColor)
+{
+	if(!is_visible(pDst))
+	{
+		return;
+	}
+
+	SDL_Rect lDst = {pDst.x - view.x, pDst.y - view.y, pDst.w, pDst.h};
+	target->push(pLayer, pTexture, pSrc, lDst, pIsFlipped, pColor);
+}
+
+/**
+ * draw_text
+ * \param pText : Text
+ * \param pX : Position X (screen pixels)
+ * \param pY : Position Y (screen pixels)
+ * \param pColor : Text color
+ * \param pWrapWidth : Wrap width (pixels, 0 to only break lines on '\n')
+ * \brief Send a text to the frame renderer (HUD, not moved by the view)
+ * \return void
+ **/
+void Camera::draw_text(const char* pText, int pX, int pY, SDL_Color pColor, int pWrapWidth)
+{
+	target->draw_text(pText, pX, pY, pColor, pWrapWidth);
+}
+
+/**
+ * clear
+ * \brief Drop the commands of the frame renderer
+ * \return void
+ **/
+void Camera::clear()
+{
+	target->clear();
+}
+
+/**
+ * invalidate
+ * \brief Redraw the whole next frame of the frame renderer
+ * \return void
+ **/
+void Camera::invalidate()
+{
+	target->invalidate();
+}
@@ -0,0 +1,65 @@
+#ifndef CAMERA_H
+#define CAMERA_H
+
+#include <SDL2/SDL.h>
+#include "game_renderer.h"
+
+/**
+ * \class Camera
+ * \brief View of a level larger than the screen: follows a target inside
+ *        the map, drops the sprites outside of the view and moves the other
+ *        ones from map to screen coordinates before sending them to the
+ *        frame renderer (texts stay in screen coordinates, for the HUD)
+ **/
+class Camera : public GameRenderer
+{
+	private:
+		//Frame renderer (screen coordinates)
+		GameRenderer* target;
+
+		//Area of the map on screen, whole map (pixels)
+		SDL_Rect view;
+		SDL_Rect bounds;
+
+	public:
+		//Screen size (pixels)
+		static const int VIEW_WIDTH = 1024;
+		static const int VIEW_HEIGHT = 768;
+
+		//Constructor
+		Camera()
+		{
+			target = nullptr;
+			view = {0, 0, VIEW_WIDTH, VIEW_HEIGHT};
+			bounds = view;
+		}
+
+		//Setter for the frame renderer
+		void set_target(GameRenderer* pTarget){target = pTarget;}
+
+		//Setter for the map area (the view is kept inside)
+		void set_bounds(const SDL_Rect& pBounds);
+
+		//Center the view on an area of the map
+		void follow(const SDL_Rect& pRect);
+
+		//Getter for the area of the map on screen
+		const SDL_Rect& get_view(){return view;}
+
+		//Check if an area of the map is on screen
+		bool is_visible(const SDL_Rect& pRect){return SDL_HasIntersection(&view, &pRect) == SDL_TRUE;}
+
+		//Send a sprite in map coordinates (dropped if out of the view)
+		void push(int pLayer, SDL_Texture* pTexture, const SDL_Rect& pSrc, const SDL_Rect& pDst, bool pIsFlipped=false, SDL_Color pColor={255, 255, 255, 255}) override;
+
+		//Send a text in screen coordinates
+		void draw_text(const char* pText, int pX, int pY, SDL_Color pColor, int pWrapWidth=0) override;
+
+		//Drop the commands of the frame
+		void clear() override;
+
+		//Redraw the whole next frame
+		void invalidate() override;
+};
+
+#endif
@@ -0,0 +1,271 @@
+#include "chunk_file.h"
+#include <cstring>
+
+/**
+ * read_u32
+ * \param pData : Chunked map bytes
+ * \brief Read a little-endian 32 bits value
+ * \return Uint32 : value
+ **/
+static Uint32 read_u32(const Uint8* pData)
+{
+	return (Uint32)pData[0] | ((Uint32)pData[1] << 8) | ((Uint32)pData[2] << 16) | ((Uint32)pData[3] << 24);
+}
+
+/**
+ * write_u32
+ * \param pContent : Chunked map
+ * \param pValue : Value
+ * \brief Write a little-endian 32 bits value
+ * \return void
+ **/
+static void write_u32(std::string& pContent, Uint32 pValue)
+{
+	char lBytes[4] = {(char)(pValue & 0xFF), (char)((pValue >> 8) & 0xFF), (char)((pValue >> 16) & 0xFF), (char)((pValue >> 24) & 0xFF)};
+	pContent.append(lBytes, 4);
+}
+
+/**
+ * open
+ * \param pFile : Chunked map (closed by close, or now if it is invalid)
+ * \brief Read and check the header
+ * \return boolean : open status
+ **/
+bool ChunkFile::open(SDL_RWops* pFile)
+{
+	close();
+	if(pFile == nullptr)
+	{
+		return false;
+	}
+
+	Uint8 lHeader[HEADER_SIZE];
+	Sint64 lSize = SDL_RWsize(pFile);
+	if(lSize < HEADER_SIZE || SDL_RWread(pFile, lHeader, HEADER_SIZE, 1) != 1 || memcmp(lHeader, "ECHK", 4) != 0 ||
+		read_u32(lHeader + 4) != VERSION || (int)read_u32(lHeader + 16) != CHUNK_TILES)
+	{
+		SDL_RWclose(pFile);
+		return false;
+	}
+
+	file = pFile;
+	file_size = lSize;
+	width = (int)read_u32(lHeader + 8);
+	height = (int)read_u32(lHeader + 12);
+	player_x = (int)read_u32(lHeader + 20);
+	player_y = (int)read_u32(lHeader + 24);
+
+	//Same limits as a parsed map (pixel coordinates stay in an int)
+	if(width <= 0 || height <= 0 || width > LevelMap::MAX_TILES || height > LevelMap::MAX_TILES ||
+		player_x < 0 || player_y < 0 || player_x >= width || player_y >= height)
+	{
+		close();
+		return false;
+	}
+
+	chunks_x = (width + CHUNK_TILES - 1) / CHUNK_TILES;
+	chunks_y = (height + CHUNK_TILES - 1) / CHUNK_TILES;
+
+	return true;
+}
+
+/**
+ * close
+ * \brief Close the chunked map
+ * \return void
+ **/
+void ChunkFile::close()
+{
+	if(file != nullptr)
+	{
+		SDL_RWclose(file);
+		file = nullptr;
+	}
+}
+
+/**
+ * read_chunk
+ * \param pX : Chunk X (chunks)
+ * \param pY : Chunk Y (chunks)
+ * \param pChunk : Chunk content (output)
+ * \brief Read the index entry of a chunk, then its records (their counts are
+ *        checked against the file size before anything is allocated)
+ * \return boolean : read status (false if the file is truncated or corrupted)
+ **/
+bool ChunkFile::read_chunk(int pX, int pY, ChunkData& pChunk)
+{
+	pChunk.x = pX;
+	pChunk.y = pY;
+	pChunk.ground.clear();
+	pChunk.entities.clear();
+
+	if(file == nullptr || pX < 0 || pY < 0 || pX >= chunks_x || pY >= chunks_y)
+	{
+		return file != nullptr;
+	}
+
+	Uint8 lEntry[INDEX_ENTRY_SIZE];
+	Sint64 lEntryOffset = HEADER_SIZE + ((Sint64)pY * chunks_x + pX) * INDEX_ENTRY_SIZE;
+	if(SDL_RWseek(file, lEntryOffset, RW_SEEK_SET) < 0 || SDL_RWread(file, lEntry, INDEX_ENTRY_SIZE, 1) != 1)
+	{
+		return false;
+	}
+
+	Uint32 lOffset = read_u32(lEntry);
+	Uint32 lGroundCount = read_u32(lEntry + 4);
+	Uint32 lEntityCount = read_u32(lEntry + 8);
+	Sint64 lRecords = (Sint64)lGroundCount + lEntityCount;
+	if(lRecords == 0)
+	{
+		return true;
+	}
+
+	if(lRecords > (file_size - lOffset) / (Sint64)LevelMap::RECORD_SIZE)
+	{
+		return false;
+	}
+
+	std::vector<Uint8> lData(lRecords * LevelMap::RECORD_SIZE);
+	if(SDL_RWseek(file, lOffset, RW_SEEK_SET) < 0 || SDL_RWread(file, lData.data(), lData.size(), 1) != 1)
+	{
+		return false;
+	}
+
+	const Uint8* lRecord = lData.data();
+	pChunk.ground.resize(lGroundCount);
+	for(auto &lRect : pChunk.ground)
+	{
+		lRect.x = (Sint32)read_u32(lRecord);
+		lRect.y = (Sint32)read_u32(lRecord + 4);
+		lRect.w = (Sint32)read_u32(lRecord + 8);
+		lRect.h = (Sint32)read_u32(lRecord + 12);
+		lRecord += LevelMap::RECORD_SIZE;
+	}
+
+	pChunk.entities.resize(lEntityCount);
+	for(auto &lEntity : pChunk.entities)
+	{
+		lEntity.type = (Sint32)read_u32(lRecord);
+		lEntity.x = (Sint32)read_u32(lRecord + 4);
+		lEntity.y = (Sint32)read_u32(lRecord + 8);
+		lEntity.x_end = (Sint32)read_u32(lRecord + 12);
+		lRecord += LevelMap::RECORD_SIZE;
+	}
+
+	return true;
+}
+
+/**
+ * write_header
+ * \param pContent : Chunked map (output)
+ * \param pWidth : Map width (tiles)
+ * \param pHeight : Map height (tiles)
+ * \param pPlayerX : Player start X (tiles)
+ * \param pPlayerY : Player start Y (tiles)
+ * \brief Write the header (the index follows, one entry per chunk)
+ * \return void
+ **/
+void ChunkFile::write_header(std::string& pContent, int pWidth, int pHeight, int pPlayerX, int pPlayerY)
+{
+	pContent.append("ECHK", 4);
+	write_u32(pContent, VERSION);
+	write_u32(pContent, pWidth);
+	write_u32(pContent, pHeight);
+	write_u32(pContent, CHUNK_TILES);
+	write_u32(pContent, pPlayerX);
+	write_u32(pContent, pPlayerY);
+}
+
+/**
+ * write_index_entry
+ * \param pContent : Chunked map (output)
+ * \param pOffset : Offset of the chunk records in the file
+ * \param pGroundCount : Ground rects of the chunk
+ * \param pEntityCount : Entities of the chunk
+ * \brief Write the index entry of a chunk
+ * \return void
+ **/
+void ChunkFile::write_index_entry(std::string& pContent, Uint32 pOffset, Uint32 pGroundCount, Uint32 pEntityCount)
+{
+	write_u32(pContent, pOffset);
+	write_u32(pContent, pGroundCount);
+	write_u32(pContent, pEntityCount);
+}
+
+/**
+ * write_chunk
+ * \param pContent : Chunked map (output)
+ * \param pChunk : Chunk content
+ * \brief Write the ground then the entity records of a chunk
+ * \return void
+ **/
+void ChunkFile::write_chunk(std::string& pContent, const ChunkData& pChunk)
+{
+	for(auto &lRect : pChunk.ground)
+	{
+		write_u32(pContent, lRect.x);
+		write_u32(pContent, lRect.y);
+		write_u32(pContent, lRect.w);
+		write_u32(pContent, lRect.h);
+	}
+
+	for(auto &lEntity : pChunk.entities)
+	{
+		write_u32(pContent, lEntity.type);
+		write_u32(pContent, lEntity.x);
+		write_u32(pContent, lEntity.y);
+		write_u32(pContent, lEntity.x_end);
+	}
+}
+
+/**
+ * write
+ * \param pMap : Parsed map
+ * \param pContent : Chunked map (output)
+ * \brief Split a map into chunks (the player start goes to the header) and serialize it
+ * \return void
+ **/
+void ChunkFile::write(const LevelMap& pMap, std::string& pContent)
+{
+	int lChunksX = (pMap.width + CHUNK_TILES - 1) / CHUNK_TILES;
+	int lChunksY = (pMap.height + CHUNK_TILES - 1) / CHUNK_TILES;
+	std::vector<ChunkData> lChunks(lChunksX * lChunksY);
+
+	int lPlayerX{0};
+	int lPlayerY{0};
+
+	for(auto &lRect : pMap.ground)
+	{
+		int lX = SDL_max(0, SDL_min(lChunksX - 1, chunk_of(lRect.x / LevelMap::TILE_SIZE)));
+		int lY = SDL_max(0, SDL_min(lChunksY - 1, chunk_of(lRect.y / LevelMap::TILE_SIZE)));
+		lChunks[lY * lChunksX + lX].ground.push_back(lRect);
+	}
+
+	for(auto &lEntity : pMap.entities)
+	{
+		if(lEntity.type == 'P')
+		{
+			lPlayerX = lEntity.x;
+			lPlayerY = lEntity.y;
+			continue;
+		}
+		int lX = SDL_max(0, SDL_min(lChunksX - 1, chunk_of(lEntity.x)));
+		int lY = SDL_max(0, SDL_min(lChunksY - 1, chunk_of(lEntity.y)));
+		lChunks[lY * lChunksX + lX].entities.push_back(lEntity);
+	}
+
+	write_header(pContent, pMap.width, pMap.height, lPlayerX, lPlayerY);
+
+	Uint32 lOffset = HEADER_SIZE + (Uint32)lChunks.size() * INDEX_ENTRY_SIZE;
+	for(auto &lChunk : lChunks)
+	{
+		Uint32 lRecords = (Uint32)(lChunk.ground.size() + lChunk.entities.size());
+		write_index_entry(pContent, (lRecords > 0) ? lOffset : 0, lChunk.ground.size(), lChunk.entities.size());
+		lOffset += lRecords * LevelMap::RECORD_SIZE;
+	}
+
+	for(auto &lChunk : lChunks)
+	{
+		write_chunk(pContent, lChunk);
+	}
+}
@@ -0,0 +1,112 @@
+#ifndef CHUNK_FILE_H
+#define CHUNK_FILE_H
+
+#include <string>
+#include <vector>
+#include <SDL2/SDL.h>
+#include "level_map.h"
+
+/**
+ * \struct ChunkData
+ * \brief Content of a map chunk: ground rects (pixels) and entities (tiles)
+ *        whose tile is in the chunk
+ **/
+struct ChunkData
+{
+	//Chunk coordinates (chunks)
+	int x{0};
+	int y{0};
+
+	std::vector<SDL_Rect> ground;
+	std::vector<LevelMap::Entity> entities;
+
+	//Read status (false if a background read failed, the chunk is empty)
+	bool is_valid{true};
+};
+
+/**
+ * \class ChunkFile
+ * \brief Chunked level map (lvl_map.chunks, written by levelc) read one
+ *        chunk at a time: huge maps are never loaded whole
+ *
+ * Layout (little-endian 32 bits values):
+ *  - header : "ECHK", version, width, height (tiles), chunk size (tiles), player x, y (tiles)
+ *  - index  : offset, ground count, entity count of every chunk (row by row, 0 when empty)
+ *  - chunks : ground then entity records of each chunk (LevelMap compiled records)
+ **/
+class ChunkFile
+{
+	private:
+		SDL_RWops* file;
+		Sint64 file_size;
+
+		int width;
+		int height;
+		int player_x;
+		int player_y;
+
+		//Chunks per row and per column
+		int chunks_x;
+		int chunks_y;
+
+	public:
+		static const Uint32 VERSION = 1;
+		static const Uint32 HEADER_SIZE = 28;
+		static const Uint32 INDEX_ENTRY_SIZE = 12;
+
+		//Chunk size (tiles)
+		static const int CHUNK_TILES = 16;
+
+		//Constructor
+		ChunkFile()
+		{
+			file = nullptr;
+			file_size = 0;
+			width = 0;
+			height = 0;
+			player_x = 0;
+			player_y = 0;
+			chunks_x = 0;
+			chunks_y = 0;
+		}
+
+		//Destructor
+		~ChunkFile()
+		{
+			close();
+		}
+
+		//Read the header of an opened chunked map (the file is closed by close)
+		bool open(SDL_RWops* pFile);
+
+		//Close the file
+		void close();
+
+		//Read a chunk (empty if out of the map, failed if its records do not fit in the file)
+		bool read_chunk(int pX, int pY, ChunkData& pChunk);
+
+		//Getters for the map size (tiles)
+		int get_width(){return width;}
+		int get_height(){return height;}
+
+		//Getters for the player start (tiles)
+		int get_player_x(){return player_x;}
+		int get_player_y(){return player_y;}
+
+		//Chunk of a tile
+		static int chunk_of(int pTile){return (pTile >= 0) ? pTile / CHUNK_TILES : (pTile - CHUNK_TILES + 1) / CHUNK_TILES;}
+
+		//Write the header of a chunked map
+		static void write_header(std::string& pContent, int pWidth, int pHeight, int pPlayerX, int pPlayerY);
+
+		//Write an index entry
+		static void write_index_entry(std::string& pContent, Uint32 pOffset, Uint32 pGroundCount, Uint32 pEntityCount);
+
+		//Write the records of a chunk
+		static void write_chunk(std::string& pContent, const ChunkData& pChunk);
+
+		//Split a parsed map into chunks and serialize it
+		static void write(const LevelMap& pMap, std::string& pContent);
+};
+
+#endif
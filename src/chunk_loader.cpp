@@ -0,0 +1,127 @@
+#include "chunk_loader.h"
+#include <iostream>
+
+/**
+ * start
+ * \param pFile : Chunked map
+ * \brief Read the header of the chunked map and start the worker thread
+ * \return boolean : start status
+ **/
+bool ChunkLoader::start(SDL_RWops* pFile)
+{
+	stop();
+	if(!file.open(pFile))
+	{
+		return false;
+	}
+
+	is_stopping = false;
+	worker = std::thread(&ChunkLoader::run_worker, this);
+	return true;
+}
+
+/**
+ * stop
+ * \brief Stop the worker thread, drop the pending chunks and close the file
+ * \return void
+ **/
+void ChunkLoader::stop()
+{
+	{
+		std::lock_guard<std::mutex> lGuard(lock);
+		is_stopping = true;
+		requests.clear();
+		loaded.clear();
+	}
+	work_cond.notify_all();
+
+	if(worker.joinable())
+	{
+		worker.join();
+	}
+	file.close();
+}
+
+/**
+ * run_worker
+ * \brief Worker thread loop: read the requested chunks
+ * \return void
+ **/
+void ChunkLoader::run_worker()
+{
+	while(true)
+	{
+		SDL_Point lRequest;
+		{
+			std::unique_lock<std::mutex> lGuard(lock);
+			work_cond.wait(lGuard, [this]{return is_stopping || !requests.empty();});
+			if(is_stopping)
+			{
+				return;
+			}
+
+			lRequest = requests.front();
+			requests.pop_front();
+		}
+
+		//Failed reads are given back too (requested again by the level)
+		ChunkData lChunk;
+		lChunk.is_valid = load(lRequest.x, lRequest.y, lChunk);
+		if(!lChunk.is_valid)
+		{
+			std::cerr << "Cannot read map chunk " << lRequest.x << "," << lRequest.y << std::endl;
+		}
+
+		std::lock_guard<std::mutex> lGuard(lock);
+		loaded.push_back(std::move(lChunk));
+	}
+}
+
+/**
+ * request
+ * \param pX : Chunk X (chunks)
+ * \param pY : Chunk Y (chunks)
+ * \brief Read a chunk on the worker thread (taken back with poll)
+ * \return void
+ **/
+void ChunkLoader::request(int pX, int pY)
+{
+	{
+		std::lock_guard<std::mutex> lGuard(lock);
+		requests.push_back({pX, pY});
+	}
+	work_cond.notify_one();
+}
+
+/**
+ * poll
+ * \param pChunk : Chunk read (output)
+ * \brief Take the oldest chunk read by the worker thread
+ * \return boolean : poll status (false if no chunk is ready)
+ **/
+bool ChunkLoader::poll(ChunkData& pChunk)
+{
+	std::lock_guard<std::mutex> lGuard(lock);
+	if(loaded.empty())
+	{
+		return false;
+	}
+
+	pChunk = std::move(loaded.front());
+	loaded.pop_front();
+	return true;
+}
+
+/**
+ * load
+ * \param pX : Chunk X (chunks)
+ * \param pY : Chunk Y (chunks)
+ * \param pChunk : Chunk read (output)
+ * \brief Read a chunk on the calling thread
+ * \return boolean : read status
+ **/
+bool ChunkLoader::load(int pX, int pY, ChunkData& pChunk)
+{
+	std::lock_guard<std::mutex> lGuard(file_lock);
+	return file.read_chunk(pX, pY, pChunk);
+}
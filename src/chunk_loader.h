@@ -0,0 +1,74 @@
+#ifndef CHUNK_LOADER_H
+#define CHUNK_LOADER_H
+
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <SDL2/SDL.h>
+#include "chunk_file.h"
+
+/**
+ * \class ChunkLoader
+ * \brief Background reads of a chunked map: chunks requested around the
+ *        player are read by a worker thread and taken back by the level
+ *        (a chunk needed right now can also be read on the calling thread)
+ **/
+class ChunkLoader
+{
+	private:
+		ChunkFile file;
+
+		//Guards the file reads (worker and immediate loads)
+		std::mutex file_lock;
+
+		std::thread worker;
+		std::deque<SDL_Point> requests;
+		std::deque<ChunkData> loaded;
+		bool is_stopping;
+
+		//Guards the requests and the loaded chunks
+		std::mutex lock;
+		std::condition_variable work_cond;
+
+		//Worker thread loop
+		void run_worker();
+
+	public:
+		//Constructor
+		ChunkLoader()
+		{
+			is_stopping = false;
+		}
+
+		//Destructor
+		~ChunkLoader()
+		{
+			stop();
+		}
+
+		//Read the header of the chunked map and start the worker thread
+		bool start(SDL_RWops* pFile);
+
+		//Stop the worker thread and close the file
+		void stop();
+
+		//Read a chunk in the background
+		void request(int pX, int pY);
+
+		//Take a chunk read in the background (check its read status)
+		bool poll(ChunkData& pChunk);
+
+		//Read a chunk now
+		bool load(int pX, int pY, ChunkData& pChunk);
+
+		//Getters for the map size (tiles)
+		int get_width(){return file.get_width();}
+		int get_height(){return file.get_height();}
+
+		//Getters for the player start (tiles)
+		int get_player_x(){return file.get_player_x();}
+		int get_player_y(){return file.get_player_y();}
+};
+
+#endif
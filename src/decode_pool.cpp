@@ -0,0 +1,188 @@
+#include "decode_pool.h"
+#include <iostream>
+
+/**
+ * start
+ * \param pVfs : Game files
+ * \param pPixelCache : Decoded images cache (nullptr to always decode)
+ * \brief Start the worker threads (one per core minus the calling thread)
+ * \return void
+ **/
+void DecodePool::start(Vfs* pVfs, PixelCache* pPixelCache)
+{
+	vfs = pVfs;
+	pixel_cache = pPixelCache;
+	is_stopping = false;
+
+	int lCount = SDL_GetCPUCount() - 1;
+	if(lCount < 1)
+	{
+		lCount = 1;
+	}
+
+	for(int lIdx = 0; lIdx < lCount; lIdx++)
+	{
+		workers.push_back(std::thread(&DecodePool::run_worker, this));
+	}
+}
+
+/**
+ * stop
+ * \brief Stop and join the worker threads
+ * \return void
+ **/
+void DecodePool::stop()
+{
+	{
+		std::lock_guard<std::mutex> lGuard(lock);
+		is_stopping = true;
+	}
+	work_cond.notify_all();
+
+	for(auto &lWorker : workers)
+	{
+		lWorker.join();
+	}
+	workers.clear();
+}
+
+/**
+ * run_worker
+ * \brief Worker thread loop: decode the images of the pending batches
+ * \return void
+ **/
+void DecodePool::run_worker()
+{
+	while(true)
+	{
+		Batch* lBatch = nullptr;
+		size_t lIdx{0};
+		{
+			std::unique_lock<std::mutex> lGuard(lock);
+			work_cond.wait(lGuard, [this]{return is_stopping || !batches.empty();});
+			if(is_stopping)
+			{
+				return;
+			}
+
+			lBatch = batches.front();
+			take(lBatch, lIdx);
+		}
+
+		decode_image(lBatch, lIdx);
+	}
+}
+
+/**
+ * take
+ * \param pBatch : Pending batch
+ * \param pIdx : Index of the taken image (output)
+ * \brief Take the next image of a batch (the pool lock must be held)
+ * \return boolean : false if every image of the batch is already taken
+ **/
+bool DecodePool::take(Batch* pBatch, size_t& pIdx)
+{
+	if(pBatch->next >= pBatch->ids->size())
+	{
+		return false;
+	}
+
+	pIdx = pBatch->next++;
+	if(pBatch->next == pBatch->ids->size())
+	{
+		//Every image is taken : the batch leaves the queue
+		for(auto lIt = batches.begin(); lIt != batches.end(); lIt++)
+		{
+			if(*lIt == pBatch)
+			{
+				batches.erase(lIt);
+				break;
+			}
+		}
+	}
+	return true;
+}
+
+/**
+ * decode_image
+ * \param pBatch : Batch of the image
+ * \param pIdx : Index of the image in the batch
+ * \brief Decode a taken image (the batch lives until every image is done)
+ * \return void
+ **/
+void DecodePool::decode_image(Batch* pBatch, size_t pIdx)
+{
+	AssetId lId = (*pBatch->ids)[pIdx];
+
+	//Cached pixels first (no decode nor conversion)
+	SDL_Surface* lImage = nullptr;
+	if(pixel_cache != nullptr)
+	{
+		lImage = pixel_cache->load(lId);
+	}
+
+	if(lImage == nullptr)
+	{
+		lImage = IMG_Load_RW(vfs->open(lId), 1);
+		if(lImage == nullptr)
+		{
+			std::cerr << "Cannot load image: " + vfs->get_name(lId) << std::endl;
+		}
+		else if(pixel_cache != nullptr)
+		{
+			lImage = pixel_cache->store(lId, lImage);
+		}
+	}
+
+	{
+		std::lock_guard<std::mutex> lGuard(lock);
+		(*pBatch->images)[pIdx] = lImage;
+		pBatch->done++;
+	}
+	done_cond.notify_all();
+}
+
+/**
+ * decode
+ * \param pIds : Images to decode
+ * \param pImages : Decoded surfaces, in the same order (output, nullptr on failure)
+ * \brief Decode a batch of images on the worker threads and the calling thread
+ * \return void
+ **/
+void DecodePool::decode(const std::vector<AssetId>& pIds, std::vector<SDL_Surface*>& pImages)
+{
+	pImages.assign(pIds.size(), nullptr);
+	if(pIds.empty())
+	{
+		return;
+	}
+
+	Batch lBatch;
+	lBatch.ids = &pIds;
+	lBatch.images = &pImages;
+	lBatch.next = 0;
+	lBatch.done = 0;
+
+	{
+		std::lock_guard<std::mutex> lGuard(lock);
+		batches.push_back(&lBatch);
+	}
+	work_cond.notify_all();
+
+	//The calling thread decodes too (the pool may be busy with another batch)
+	while(true)
+	{
+		size_t lIdx{0};
+		{
+			std::lock_guard<std::mutex> lGuard(lock);
+			if(!take(&lBatch, lIdx))
+			{
+				break;
+			}
+		}
+		decode_image(&lBatch, lIdx);
+	}
+
+	std::unique_lock<std::mutex> lGuard(lock);
+	done_cond.wait(lGuard, [&lBatch]{return lBatch.done == lBatch.ids->size();});
+}
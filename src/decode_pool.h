@@ -0,0 +1,81 @@
+#ifndef DECODE_POOL_H
+#define DECODE_POOL_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <SDL2/SDL.h>
+#include "vfs.h"
+#include "pixel_cache.h"
+
+#ifdef __APPLE__
+#include <SDL2_image/SDL_image.h>
+#else
+#include <SDL2/SDL_image.h>
+#endif
+
+/**
+ * \class DecodePool
+ * \brief Worker threads decoding batches of images into surfaces
+ *        (textures are then created from the surfaces on the render thread)
+ **/
+class DecodePool
+{
+	private:
+		struct Batch
+		{
+			const std::vector<AssetId>* ids;
+			std::vector<SDL_Surface*>* images;
+			size_t next;
+			size_t done;
+		};
+
+		Vfs* vfs;
+		PixelCache* pixel_cache;
+
+		std::vector<std::thread> workers;
+		std::deque<Batch*> batches;
+		bool is_stopping;
+
+		std::mutex lock;
+		std::condition_variable work_cond;
+		std::condition_variable done_cond;
+
+		//Worker thread loop
+		void run_worker();
+
+		//Take the next image of a batch (lock held, false if every image is taken)
+		bool take(Batch* pBatch, size_t& pIdx);
+
+		//Decode a taken image of a batch
+		void decode_image(Batch* pBatch, size_t pIdx);
+
+	public:
+		//Constructor
+		DecodePool()
+		{
+			vfs = nullptr;
+			pixel_cache = nullptr;
+			is_stopping = false;
+		}
+
+		//Destructor
+		~DecodePool()
+		{
+			stop();
+		}
+
+		//Start the worker threads (one per core, the calling thread helps too)
+		void start(Vfs* pVfs, PixelCache* pPixelCache);
+
+		//Stop the worker threads
+		void stop();
+
+		//Decode a batch of images (blocks until every image is decoded, nullptr on failure,
+		//images come from the pixel cache when they are in it)
+		void decode(const std::vector<AssetId>& pIds, std::vector<SDL_Surface*>& pImages);
+};
+
+#endif
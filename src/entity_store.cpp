@@ -0,0 +1,290 @@
+#include "entity_store.h"
+#include "level_map.h"
+
+//Layer, size, offset, frames and period of every kind
+const EntityStore::KindInfo EntityStore::KIND_INFOS[KINDS] = {
+	{GameRenderer::LAYER_ITEMS, 64, 126, 0, 0, 0, 0},		//Door
+	{GameRenderer::LAYER_PROPS, 32, 112, -48, 0, 0, 0},		//Pencil
+	{GameRenderer::LAYER_PROPS, 64, 64, 0, 64, 2, 210},		//Spike
+	{GameRenderer::LAYER_PROPS, 96, 64, 0, 96, 3, 1000},		//Plantivorus
+	{GameRenderer::LAYER_ENEMIES, 32, 64, -48, 32, 3, 600},	//Arachne
+	{GameRenderer::LAYER_ENEMIES, 64, 64, -32, 0, 2, 600},	//Ghost (bobbing, one frame)
+	{GameRenderer::LAYER_ENEMIES, 64, 64, 0, 64, 3, 180},		//Monster
+	{GameRenderer::LAYER_ITEMS, 64, 64, 0, 0, 0, 0}			//Time bonus
+};
+
+//Vertical move of a ghost (pixels)
+static const int GHOST_OFFSET = 50;
+
+/**
+ * kind_of
+ * \param pType : Map character (LevelMap entity type)
+ * \brief Give the kind of a map entity
+ * \return int : kind (-1 for the player and unknown characters)
+ **/
+int EntityStore::kind_of(int pType)
+{
+	switch(pType)
+	{
+		case 'D':
+			return DOOR;
+		case 'C':
+			return PENCIL;
+		case 'S':
+			return SPIKE;
+		case 'F':
+			return PLANT;
+		case 'A':
+			return ARACHNE;
+		case 'G':
+			return GHOST;
+		case LevelMap::MONSTER:
+			return MONSTER;
+		case 'T':
+			return TIME_BONUS;
+	}
+	return -1;
+}
+
+/**
+ * add
+ * \param pKind : Entity kind
+ * \param pX : Tile X
+ * \param pY : Tile Y
+ * \param pXEnd : End of the range (tiles, monsters only)
+ * \param pIndex : Spatial hash listing the entities (nullptr if none)
+ * \brief Add an entity on a tile
+ * \return void
+ **/
+void EntityStore::add(int pKind, int pX, int pY, int pXEnd, SpatialHash* pIndex)
+{
+	const KindInfo& lInfo = KIND_INFOS[pKind];
+
+	rects.push_back({pX * LevelMap::TILE_SIZE, pY * LevelMap::TILE_SIZE + lInfo.offset_y, lInfo.width, lInfo.height});
+	last_positions.push_back({rects.back().x, rects.back().y});
+	kinds.push_back(pKind);
+	frames.push_back(0);
+	periods.push_back(lInfo.period);
+	phases.push_back((pX + 2 * pY) % PHASES);
+	spawns.push_back({pX, pY});
+	patrols.push_back({pX, (pKind == MONSTER) ? pXEnd : pX, 1});
+	groups[pKind * PHASES + phases.back()].push_back(rects.size() - 1);
+
+	if(pIndex != nullptr)
+	{
+		pIndex->insert(rects.back(), index_key, rects.size() - 1);
+	}
+}
+
+/**
+ * remove
+ * \param pIdx : Entity index
+ * \param pIndex : Spatial hash listing the entities (nullptr if none)
+ * \brief Remove an entity, the last entity is moved into its slot
+ * \return void
+ **/
+void EntityStore::remove(size_t pIdx, SpatialHash* pIndex)
+{
+	size_t lLast = kinds.size() - 1;
+	if(pIndex != nullptr)
+	{
+		pIndex->remove(rects[pIdx], index_key, pIdx);
+		if(pIdx != lLast)
+		{
+			pIndex->remove(rects[lLast], index_key, lLast);
+			pIndex->insert(rects[lLast], index_key, pIdx);
+		}
+	}
+
+	regroup(pIdx, -1);
+	if(pIdx != lLast)
+	{
+		regroup(lLast, pIdx);
+		rects[pIdx] = rects[lLast];
+		last_positions[pIdx] = last_positions[lLast];
+		kinds[pIdx] = kinds[lLast];
+		frames[pIdx] = frames[lLast];
+		periods[pIdx] = periods[lLast];
+		phases[pIdx] = phases[lLast];
+		spawns[pIdx] = spawns[lLast];
+		patrols[pIdx] = patrols[lLast];
+	}
+
+	rects.pop_back();
+	last_positions.pop_back();
+	kinds.pop_back();
+	frames.pop_back();
+	periods.pop_back();
+	phases.pop_back();
+	spawns.pop_back();
+	patrols.pop_back();
+}
+
+/**
+ * clear
+ * \param pIndex : Spatial hash listing the entities (nullptr if none)
+ * \brief Remove every entity
+ * \return void
+ **/
+void EntityStore::clear(SpatialHash* pIndex)
+{
+	if(pIndex != nullptr)
+	{
+		for(size_t lIdx = 0; lIdx < rects.size(); lIdx++)
+		{
+			pIndex->remove(rects[lIdx], index_key, lIdx);
+		}
+	}
+
+	rects.clear();
+	last_positions.clear();
+	kinds.clear();
+	frames.clear();
+	periods.clear();
+	phases.clear();
+	spawns.clear();
+	patrols.clear();
+	for(auto &lGroup : groups)
+	{
+		lGroup.clear();
+	}
+}
+
+/**
+ * regroup
+ * \param pFrom : Entity index
+ * \param pTo : New entity index (-1 to remove it)
+ * \brief Replace an index in its kind and phase list (swap removal, the
+ *        order of a list does not matter)
+ * \return void
+ **/
+void EntityStore::regroup(size_t pFrom, int pTo)
+{
+	std::vector<Uint32>& lGroup = groups[kinds[pFrom] * PHASES + phases[pFrom]];
+	for(size_t lIdx = 0; lIdx < lGroup.size(); lIdx++)
+	{
+		if(lGroup[lIdx] != pFrom)
+		{
+			continue;
+		}
+
+		if(pTo >= 0)
+		{
+			lGroup[lIdx] = pTo;
+		}
+		else
+		{
+			lGroup[lIdx] = lGroup.back();
+			lGroup.pop_back();
+		}
+		return;
+	}
+}
+
+/**
+ * save_positions
+ * \brief Keep the positions of the entities before a simulation step
+ * \return void
+ **/
+void EntityStore::save_positions()
+{
+	for(size_t lIdx = 0; lIdx < rects.size(); lIdx++)
+	{
+		last_positions[lIdx].x = rects[lIdx].x;
+		last_positions[lIdx].y = rects[lIdx].y;
+	}
+}
+
+/**
+ * step
+ * \param pKind : Entity kind
+ * \param pPhase : Animation phase
+ * \param pIndex : Spatial hash listing the entities (nullptr if none)
+ * \brief Move every entity of a kind and phase to its next animation step
+ *        (monsters walk one tile along their range, ghosts bob up and down),
+ *        only the entities listed for this kind and phase are visited
+ * \return void
+ **/
+void EntityStore::step(int pKind, int pPhase, SpatialHash* pIndex)
+{
+	int lFrameCount = KIND_INFOS[pKind].frame_count;
+	if(lFrameCount == 0)
+	{
+		return;
+	}
+
+	for(Uint32 lIdx : groups[pKind * PHASES + pPhase])
+	{
+		SDL_Rect lFrom = rects[lIdx];
+		if(pKind == GHOST)
+		{
+			rects[lIdx].y += (frames[lIdx] == 0) ? GHOST_OFFSET : -GHOST_OFFSET;
+		}
+		else if(pKind == MONSTER)
+		{
+			Patrol& lPatrol = patrols[lIdx];
+			int lTileX = rects[lIdx].x / LevelMap::TILE_SIZE;
+			if(lPatrol.is_right)
+			{
+				if(lTileX < lPatrol.x_max)
+				{
+					rects[lIdx].x += LevelMap::TILE_SIZE;
+				}
+				else
+				{
+					lPatrol.is_right = 0;
+				}
+			}
+			else
+			{
+				if(lTileX > lPatrol.x_min)
+				{
+					rects[lIdx].x -= LevelMap::TILE_SIZE;
+				}
+				else
+				{
+					lPatrol.is_right = 1;
+				}
+			}
+		}
+
+		if(pIndex != nullptr && (lFrom.x != rects[lIdx].x || lFrom.y != rects[lIdx].y))
+		{
+			pIndex->move(lFrom, rects[lIdx], index_key, lIdx);
+		}
+
+		frames[lIdx] = (frames[lIdx] + 1) % lFrameCount;
+	}
+}
+
+/**
+ * render
+ * \param pRenderer : Frame renderer
+ * \param pSheets : Sprite sheet of every kind
+ * \param pAlpha : Time since the last simulation step (fraction of a step)
+ * \brief Add the sprites to the frame renderer, between their previous and
+ *        their last position (monsters going right are mirrored)
+ * \return void
+ **/
+void EntityStore::render(GameRenderer* pRenderer, const SpriteSheet* pSheets, float pAlpha) const
+{
+	for(size_t lIdx = 0; lIdx < kinds.size(); lIdx++)
+	{
+		const KindInfo& lInfo = KIND_INFOS[kinds[lIdx]];
+		const SpriteSheet& lSheet = pSheets[kinds[lIdx]];
+
+		SDL_Rect lSrc = lSheet.frame({frames[lIdx] * lInfo.frame_stride, 0, lInfo.width, lInfo.height});
+		bool lIsFlipped = kinds[lIdx] == MONSTER && patrols[lIdx].is_right;
+		const SDL_Rect& lRect = rects[lIdx];
+		const SDL_Point& lLast = last_positions[lIdx];
+		if(lLast.x == lRect.x && lLast.y == lRect.y)
+		{
+			pRenderer->push(lInfo.layer, lSheet.texture, lSrc, lRect, lIsFlipped);
+		}
+		else
+		{
+			SDL_Rect lFrom = {lLast.x, lLast.y, lRect.w, lRect.h};
+			pRenderer->push(lInfo.layer, lSheet.texture, lSrc, GameRenderer::interpolate(lFrom, lRect, pAlpha), lIsFlipped);
+		}
+	}
+}
@@ -0,0 +1,139 @@
+#ifndef ENTITY_STORE_H
+#define ENTITY_STORE_H
+
+#include <vector>
+#include <SDL2/SDL.h>
+#include "sprite_sheet.h"
+#include "game_renderer.h"
+#include "spatial_hash.h"
+
+/**
+ * \class EntityStore
+ * \brief Level entities (doors, pencils, spikes, plants, arachnes, ghosts,
+ *        monsters and time bonuses) stored as packed arrays: updates,
+ *        collisions and rendering sweep contiguous memory
+ *
+ * Entity i is the i-th item of every array. Removing an entity moves the
+ * last one into its slot: indices are not stable across a remove. The
+ * indices are also listed by kind and phase, a step only visits its list. When a
+ * spatial hash is given, the entries of the entities (listed under the key
+ * of the store) follow their adds, moves and removes.
+ **/
+class EntityStore
+{
+	public:
+		//Kinds (sprite sheet, size, layer and behaviour of an entity)
+		static const int DOOR = 0;
+		static const int PENCIL = 1;
+		static const int SPIKE = 2;
+		static const int PLANT = 3;
+		static const int ARACHNE = 4;
+		static const int GHOST = 5;
+		static const int MONSTER = 6;
+		static const int TIME_BONUS = 7;
+		static const int KINDS = 8;
+
+		//Animation phases of a kind (neighbours do not step in lockstep)
+		static const int PHASES = 4;
+
+		//Kind masks of the queries
+		static const Uint32 DANGER_MASK = (1 << SPIKE) | (1 << PLANT) | (1 << GHOST) | (1 << ARACHNE) | (1 << MONSTER);
+		static const Uint32 ERASABLE_MASK = (1 << SPIKE) | (1 << PLANT) | (1 << ARACHNE) | (1 << MONSTER) | (1 << TIME_BONUS);
+
+		//Patrol of a monster (tiles)
+		struct Patrol
+		{
+			Sint32 x_min;
+			Sint32 x_max;
+			Sint32 is_right;
+		};
+
+	private:
+		//Description of a kind
+		struct KindInfo
+		{
+			int layer;
+			int width;
+			int height;
+			//Offset of the sprite from its tile (pixels)
+			int offset_y;
+			//Frame step in the sheet and frame count (0 for a still sprite)
+			int frame_stride;
+			int frame_count;
+			//Animation period (ms, 0 for a still sprite)
+			int period;
+		};
+
+		static const KindInfo KIND_INFOS[KINDS];
+
+		//Collision and sprite rects (pixels)
+		std::vector<SDL_Rect> rects;
+
+		//Rect positions at the previous simulation step (drawn interpolated)
+		std::vector<SDL_Point> last_positions;
+
+		std::vector<Uint8> kinds;
+		std::vector<Uint8> frames;
+		std::vector<Uint16> periods;
+		std::vector<Uint8> phases;
+
+		//Spawn tile (a monster spawns at the start of its range)
+		std::vector<SDL_Point> spawns;
+
+		//Behaviour data (monsters only, the other entities keep it empty)
+		std::vector<Patrol> patrols;
+
+		//Entity indices of every kind and phase (kind * PHASES + phase)
+		std::vector<Uint32> groups[KINDS * PHASES];
+
+		//Replace an index in its kind and phase list (removed if pTo is -1)
+		void regroup(size_t pFrom, int pTo);
+
+		//Key of the entities in the spatial hash (chunk key)
+		Uint64 index_key{0};
+
+	public:
+		//Kind of a map character (-1 for the player and unknown characters)
+		static int kind_of(int pType);
+
+		//Getter for the animation period of a kind (ms)
+		static int get_kind_period(int pKind){return KIND_INFOS[pKind].period;}
+
+		//Set the key of the entities in the spatial hash
+		void set_index_key(Uint64 pKey){index_key = pKey;}
+
+		//Add an entity on a tile (pXEnd is the end of a monster range)
+		void add(int pKind, int pX, int pY, int pXEnd=0, SpatialHash* pIndex=nullptr);
+
+		//Remove an entity (the last one takes its index)
+		void remove(size_t pIdx, SpatialHash* pIndex=nullptr);
+
+		//Remove every entity
+		void clear(SpatialHash* pIndex=nullptr);
+
+		//Getter for the entity count
+		size_t size() const {return kinds.size();}
+
+		//Getters for an entity
+		const SDL_Rect& get_rect(size_t pIdx) const {return rects[pIdx];}
+		int get_kind(size_t pIdx) const {return kinds[pIdx];}
+		const SDL_Point& get_spawn(size_t pIdx) const {return spawns[pIdx];}
+		int get_period(size_t pIdx) const {return periods[pIdx];}
+
+		//Keep the positions of the previous simulation step
+		void save_positions();
+
+		//Move every entity of a kind and phase to its next animation step
+		void step(int pKind, int pPhase, SpatialHash* pIndex=nullptr);
+
+		//Check if an entity of the masked kinds intersects a rect
+		bool is_hit(size_t pIdx, const SDL_Rect& pRect, Uint32 pKindMask) const
+		{
+			return (pKindMask & (1 << kinds[pIdx])) != 0 && SDL_HasIntersection(&pRect, &rects[pIdx]);
+		}
+
+		//Add the sprites to the frame renderer (one sheet per kind, between the previous and the last step)
+		void render(GameRenderer* pRenderer, const SpriteSheet* pSheets, float pAlpha=1.0f) const;
+};
+
+#endif
@@ -0,0 +1,147 @@
+#include "frame_pacer.h"
+#include <iostream>
+
+/**
+ * start
+ * \param pFrameRate : Target frames per second
+ * \param pIsVsync : Presents wait for the vsync (no pacing wait, frames are only measured)
+ * \brief Start pacing from now
+ * \return void
+ **/
+void FramePacer::start(double pFrameRate, bool pIsVsync)
+{
+	frequency = SDL_GetPerformanceFrequency();
+	period = (Uint64)(frequency / pFrameRate);
+	is_vsync = pIsVsync;
+
+	last_frame = SDL_GetPerformanceCounter();
+	deadline = last_frame + period;
+	reset_stats();
+}
+
+/**
+ * wait
+ * \param pIsMeasured : Add the frame time to the stats (false for the idle and background frames)
+ * \brief End the frame: sleep until about 1 ms before the deadline, then spin
+ *        on the performance counter until the deadline (a late frame restarts
+ *        the deadlines from now instead of rushing the next ones)
+ * \return void
+ **/
+void FramePacer::wait(bool pIsMeasured)
+{
+	Uint64 lNow = SDL_GetPerformanceCounter();
+
+	if(!is_vsync)
+	{
+		Uint64 lSpinTime = frequency / 1000;
+		if(lNow + lSpinTime < deadline)
+		{
+			SDL_Delay((Uint32)((deadline - lNow - lSpinTime) * 1000 / frequency));
+		}
+
+		lNow = SDL_GetPerformanceCounter();
+		while(lNow < deadline)
+		{
+			lNow = SDL_GetPerformanceCounter();
+		}
+
+		deadline += period;
+		if(deadline <= lNow)
+		{
+			deadline = lNow + period;
+		}
+	}
+
+	if(pIsMeasured)
+	{
+		record((double)(lNow - last_frame) * 1000.0 / frequency);
+	}
+	last_frame = lNow;
+}
+
+/**
+ * resume
+ * \brief Restart the frame from now: the time spent blocked waiting for the
+ *        events (idle or background loop) is neither paced nor measured
+ * \return void
+ **/
+void FramePacer::resume()
+{
+	last_frame = SDL_GetPerformanceCounter();
+	deadline = last_frame + period;
+}
+
+/**
+ * record
+ * \param pFrameMs : Frame time (ms)
+ * \brief Add a frame time to the stats
+ * \return void
+ **/
+void FramePacer::record(double pFrameMs)
+{
+	frame_count++;
+	total_ms += pFrameMs;
+	if(pFrameMs > max_ms)
+	{
+		max_ms = pFrameMs;
+	}
+
+	//The last bin holds every frame longer than the histogram
+	int lBin = (int)(pFrameMs * BINS_PER_MS);
+	if(lBin >= HISTOGRAM_BINS)
+	{
+		lBin = HISTOGRAM_BINS - 1;
+	}
+	histogram[lBin]++;
+}
+
+/**
+ * get_p99
+ * \brief 99th percentile of the frame times (upper bound of its 0.1 ms bin)
+ * \return double : frame time (ms)
+ **/
+double FramePacer::get_p99()
+{
+	Uint64 lRank = frame_count - frame_count / 100;
+	Uint64 lCount{0};
+	for(int lBin = 0; lBin < (int)histogram.size(); lBin++)
+	{
+		lCount += histogram[lBin];
+		if(lCount >= lRank && lCount > 0)
+		{
+			double lUpper = (double)(lBin + 1) / BINS_PER_MS;
+			return (lUpper < max_ms) ? lUpper : max_ms;
+		}
+	}
+	return max_ms;
+}
+
+/**
+ * report
+ * \brief Print the frame time stats
+ * \return void
+ **/
+void FramePacer::report()
+{
+	if(frame_count == 0)
+	{
+		return;
+	}
+
+	std::cout << "Frame pacing (" << (is_vsync ? "vsync" : "timer") << ", " << (double)period * 1000.0 / frequency << " ms target): "
+		<< frame_count << " frames, mean " << get_mean() << " ms, p99 " << get_p99()
+		<< " ms, max " << get_max() << " ms" << std::endl;
+}
+
+/**
+ * reset_stats
+ * \brief Forget the frame time stats
+ * \return void
+ **/
+void FramePacer::reset_stats()
+{
+	frame_count = 0;
+	total_ms = 0;
+	max_ms = 0;
+	histogram.assign(HISTOGRAM_BINS, 0);
+}
@@ -0,0 +1,76 @@
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include <vector>
+#include <SDL2/SDL.h>
+
+/**
+ * \class FramePacer
+ * \brief Frame pacing on the performance counter: each frame ends on a fixed
+ *        deadline (sleep, then spin the last millisecond), or on the vsync
+ *        when the renderer presents with it
+ *
+ * Frame times are kept in a histogram (0.1 ms bins) for the mean, p99 and max.
+ **/
+class FramePacer
+{
+	private:
+		static const int HISTOGRAM_BINS = 1000;
+		static const int BINS_PER_MS = 10;
+
+		Uint64 frequency;
+		Uint64 period;
+		Uint64 deadline;
+		Uint64 last_frame;
+		bool is_vsync;
+
+		//Frame time stats
+		Uint64 frame_count;
+		double total_ms;
+		double max_ms;
+		std::vector<Uint32> histogram;
+
+		//Add a frame time to the stats
+		void record(double pFrameMs);
+
+	public:
+		//Constructor
+		FramePacer()
+		{
+			frequency = 1;
+			period = 0;
+			deadline = 0;
+			last_frame = 0;
+			is_vsync = false;
+			frame_count = 0;
+			total_ms = 0;
+			max_ms = 0;
+			histogram.assign(HISTOGRAM_BINS, 0);
+		}
+
+		//Start pacing at the given rate (only measured if presents wait for the vsync)
+		void start(double pFrameRate, bool pIsVsync);
+
+		//End the frame: wait for its deadline (its time is left out of the stats if not measured)
+		void wait(bool pIsMeasured=true);
+
+		//Restart the deadlines from now (after blocking on the events, not measured)
+		void resume();
+
+		//Getter for the mean frame time (ms)
+		double get_mean(){return (frame_count > 0) ? total_ms / frame_count : 0;}
+
+		//Getter for the 99th percentile frame time (ms)
+		double get_p99();
+
+		//Getter for the longest frame time (ms)
+		double get_max(){return max_ms;}
+
+		//Print the frame time stats
+		void report();
+
+		//Forget the frame time stats
+		void reset_stats();
+};
+
+#endif
@@ -0,0 +1,133 @@
+#include "frame_snapshot.h"
+
+/**
+ * push
+ * \param pLayer : Layer (GameRenderer::LAYER_*)
+ * \param pTexture : Sprite texture
+ * \param pSrc : Area of the texture
+ * \param pDst : Area of the screen
+ * \param pIsFlipped : Mirror the sprite horizontally
+ * \param pColor : Tint (white to keep the texture colors)
+ * \brief Record a sprite of the tick
+ * \return void
+ **/
+void FrameSnapshot::push(int pLayer, SDL_Texture* pTexture, const SDL_Rect& pSrc, const SDL_Rect& pDst, bool pIsFlipped, SDL_Color pColor)
+{
+	if(pTexture == nullptr)
+	{
+		return;
+	}
+
+	if(is_static_recording)
+	{
+		static_commands.push_back({pLayer, pTexture, pSrc, pDst, pColor, pIsFlipped});
+	}
+	else
+	{
+		commands.push_back({pLayer, pTexture, pSrc, pDst, pColor, pIsFlipped});
+	}
+}
+
+/**
+ * draw_text
+ * \param pText : Text
+ * \param pX : Position X (pixels)
+ * \param pY : Position Y (pixels)
+ * \param pColor : Text color
+ * \param pWrapWidth : Wrap width (pixels, 0 to only break lines on '\n')
+ * \brief Record a text of the tick (the glyphs are laid out when it is replayed)
+ * \return void
+ **/
+void FrameSnapshot::draw_text(const char* pText, int pX, int pY, SDL_Color pColor, int pWrapWidth)
+{
+	if(text_count == texts.size())
+	{
+		texts.push_back(Text());
+	}
+
+	Text& lText = texts[text_count++];
+	lText.text.assign(pText);
+	lText.x = pX;
+	lText.y = pY;
+	lText.color = pColor;
+	lText.wrap_width = pWrapWidth;
+}
+
+/**
+ * clear
+ * \brief Forget the recorded commands (before recording the next tick)
+ * \return void
+ **/
+void FrameSnapshot::clear()
+{
+	commands.clear();
+	text_count = 0;
+}
+
+/**
+ * replay
+ * \param pRenderer : Frame renderer
+ * \brief Send the recorded sprites and texts to a renderer
+ * \return void
+ **/
+void FrameSnapshot::replay(GameRenderer* pRenderer) const
+{
+	for(auto &lCommand : commands)
+	{
+		pRenderer->push(lCommand.layer, lCommand.texture, lCommand.src, lCommand.dst, lCommand.is_flipped, lCommand.color);
+	}
+
+	for(size_t lIdx = 0; lIdx < text_count; lIdx++)
+	{
+		const Text& lText = texts[lIdx];
+		pRenderer->draw_text(lText.text.c_str(), lText.x, lText.y, lText.color, lText.wrap_width);
+	}
+}
+
+/**
+ * begin_static
+ * \param pStamp : Stamp of the static layer
+ * \brief Forget the static layer and record the next sprites into it
+ * \return void
+ **/
+void FrameSnapshot::begin_static(Uint32 pStamp)
+{
+	static_commands.clear();
+	static_stamp = pStamp;
+	is_static_recording = true;
+}
+
+/**
+ * replay_static
+ * \param pRenderer : Frame renderer
+ * \brief Send the static layer sprites to a renderer (when it cannot be composed)
+ * \return void
+ **/
+void FrameSnapshot::replay_static(GameRenderer* pRenderer) const
+{
+	for(auto &lCommand : static_commands)
+	{
+		pRenderer->push(lCommand.layer, lCommand.texture, lCommand.src, lCommand.dst, lCommand.is_flipped, lCommand.color);
+	}
+}
+
+/**
+ * draw_static
+ * \param pRenderer : Game renderer
+ * \brief Draw the static layer sprites into the current render target, from
+ *        the lowest layer (render thread)
+ * \return void
+ **/
+void FrameSnapshot::draw_static(SDL_Renderer* pRenderer) const
+{
+	for(int lLayer = GameRenderer::LAYER_BACKGROUND; lLayer <= GameRenderer::LAYER_GROUND; lLayer++)
+	{
+		for(auto &lCommand : static_commands)
+		{
+			if(lCommand.layer == lLayer)
+			{
+				SDL_RenderCopy(pRenderer, lCommand.texture, &lCommand.src, &lCommand.dst);
+			}
+		}
+	}
+}
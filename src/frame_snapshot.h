@@ -0,0 +1,97 @@
+#ifndef FRAME_SNAPSHOT_H
+#define FRAME_SNAPSHOT_H
+
+#include <string>
+#include <vector>
+#include <SDL2/SDL.h>
+#include "game_renderer.h"
+
+/**
+ * \class FrameSnapshot
+ * \brief Render commands of one simulation tick (sprite rects and frames,
+ *        texts), recorded by the simulation thread and replayed into the
+ *        render queue by the render thread
+ *
+ * The static layer (background and ground of the view) is kept from a tick
+ * to the next and only recorded again when its stamp changes: the render
+ * thread composes it into a texture once per stamp.
+ **/
+class FrameSnapshot : public GameRenderer
+{
+	private:
+		struct Command
+		{
+			int layer;
+			SDL_Texture* texture;
+			SDL_Rect src;
+			SDL_Rect dst;
+			SDL_Color color;
+			bool is_flipped;
+		};
+
+		struct Text
+		{
+			std::string text;
+			int x;
+			int y;
+			SDL_Color color;
+			int wrap_width;
+		};
+
+		std::vector<Command> commands;
+
+		//Static layer commands and stamp, recording status
+		std::vector<Command> static_commands;
+		Uint32 static_stamp;
+		bool is_static_recording;
+
+		//Texts recorded (the strings keep their storage from a tick to the next)
+		std::vector<Text> texts;
+		size_t text_count;
+
+	public:
+		//Game time of the tick (ms)
+		Uint32 time;
+
+		//Level state after the tick (Level::PLAYING, FINISHED, FAILED or TIME_OUT)
+		int state;
+
+		//Constructor
+		FrameSnapshot()
+		{
+			text_count = 0;
+			static_stamp = 0;
+			is_static_recording = false;
+			time = 0;
+			state = 0;
+		}
+
+		//Record a sprite
+		void push(int pLayer, SDL_Texture* pTexture, const SDL_Rect& pSrc, const SDL_Rect& pDst, bool pIsFlipped=false, SDL_Color pColor={255, 255, 255, 255}) override;
+
+		//Record a text
+		void draw_text(const char* pText, int pX, int pY, SDL_Color pColor, int pWrapWidth=0) override;
+
+		//Forget the recorded commands (the static layer is kept)
+		void clear() override;
+
+		//Send the recorded commands to a renderer (without the static layer)
+		void replay(GameRenderer* pRenderer) const;
+
+		//Record the next sprites as the static layer of a stamp (until end_static)
+		void begin_static(Uint32 pStamp);
+
+		//Record the next sprites as commands again
+		void end_static(){is_static_recording = false;}
+
+		//Getter for the stamp of the static layer
+		Uint32 get_static_stamp() const {return static_stamp;}
+
+		//Send the static layer commands to a renderer
+		void replay_static(GameRenderer* pRenderer) const;
+
+		//Draw the static layer into the current render target
+		void draw_static(SDL_Renderer* pRenderer) const;
+};
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef GAME_AUDIO_H
+#define GAME_AUDIO_H
+
+#include "vfs.h"
+
+/**
+ * \class GameAudio
+ * \brief Audio interface of the game logic (AudioBank plays with SDL_mixer,
+ *        NullAudio stays silent for the headless simulations)
+ **/
+class GameAudio
+{
+	public:
+		//Destructor
+		virtual ~GameAudio(){};
+
+		//Play a loaded sound once
+		virtual void play_sound(AssetId pId) = 0;
+
+		//Play the music (keeps playing if it already is)
+		virtual void play_music(int pVolume) = 0;
+
+		//Stop the music
+		virtual void stop_music() = 0;
+};
+
+/**
+ * \class NullAudio
+ * \brief Audio without output (no audio device needed)
+ **/
+class NullAudio : public GameAudio
+{
+	public:
+		void play_sound(AssetId) override {}
+		void play_music(int) override {}
+		void stop_music() override {}
+};
+
+#endif
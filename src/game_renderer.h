@@ -0,0 +1,62 @@
+#ifndef GAME_RENDERER_H
+#define GAME_RENDERER_H
+
+#include <SDL2/SDL.h>
+
+/**
+ * \class GameRenderer
+ * \brief Drawing interface of the game logic: sprites and texts are sent as
+ *        commands on a layer (RenderQueue draws them with SDL, NullRenderer
+ *        drops them for the headless simulations)
+ **/
+class GameRenderer
+{
+	public:
+		//Layers, drawn from the lowest
+		static const int LAYER_BACKGROUND = 0;
+		static const int LAYER_GROUND = 1;
+		static const int LAYER_PROPS = 2;
+		static const int LAYER_ENEMIES = 3;
+		static const int LAYER_ITEMS = 4;
+		static const int LAYER_HUD = 5;
+		static const int LAYER_PLAYER = 6;
+		static const int LAYER_CURSOR = 7;
+
+		//Destructor
+		virtual ~GameRenderer(){};
+
+		//Add a sprite (mirrored horizontally if flipped, tinted by the color)
+		virtual void push(int pLayer, SDL_Texture* pTexture, const SDL_Rect& pSrc, const SDL_Rect& pDst, bool pIsFlipped=false, SDL_Color pColor={255, 255, 255, 255}) = 0;
+
+		//Add a text on the HUD layer ('\n' breaks lines, words are wrapped when a wrap width is given)
+		virtual void draw_text(const char* pText, int pX, int pY, SDL_Color pColor, int pWrapWidth=0) = 0;
+
+		//Drop the commands of the frame
+		virtual void clear() = 0;
+
+		//Redraw the whole next frame (a texture changed under unchanged commands)
+		virtual void invalidate(){}
+
+		//Rect between two simulation steps (0 gives the previous one, 1 the last one)
+		static SDL_Rect interpolate(const SDL_Rect& pFrom, const SDL_Rect& pTo, float pAlpha)
+		{
+			SDL_Rect lRect = pTo;
+			lRect.x = pFrom.x + (int)SDL_floorf((pTo.x - pFrom.x) * pAlpha + 0.5f);
+			lRect.y = pFrom.y + (int)SDL_floorf((pTo.y - pFrom.y) * pAlpha + 0.5f);
+			return lRect;
+		}
+};
+
+/**
+ * \class NullRenderer
+ * \brief Renderer without output (no window needed)
+ **/
+class NullRenderer : public GameRenderer
+{
+	public:
+		void push(int, SDL_Texture*, const SDL_Rect&, const SDL_Rect&, bool=false, SDL_Color={255, 255, 255, 255}) override {}
+		void draw_text(const char*, int, int, SDL_Color, int=0) override {}
+		void clear() override {}
+};
+
+#endif
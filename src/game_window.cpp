@@ -25,11 +25,31 @@ bool GameWindow::init()
 		return false;
 	}
 
+	// Dirty rects mode - Software renderer drawing into the window surface
+	// (only the changed areas are redrawn and presented)
+	const char* dirty_mode = SDL_getenv("ERASER_DIRTY_RECTS");
+	is_dirty_mode = dirty_mode != nullptr && SDL_atoi(dirty_mode) != 0;
+
+	// Frame pacing - Target rate and vsync
+	// (no vsync for the window surface of the dirty rects mode)
+	const char* fps = SDL_getenv("ERASER_FPS");
+	if(fps != nullptr && SDL_atof(fps) > 0)
+	{
+		frame_rate = SDL_atof(fps);
+	}
+	const char* vsync = SDL_getenv("ERASER_VSYNC");
+	is_vsync = !is_dirty_mode && vsync != nullptr && SDL_atoi(vsync) != 0;
+
+	// Simulation thread - Levels updated apart from the rendering
+	// (ERASER_SIM_THREAD=0 updates them in the render loop)
+	const char* sim_thread = SDL_getenv("ERASER_SIM_THREAD");
+	lvl_manager.set_threaded(sim_thread == nullptr || SDL_atoi(sim_thread) != 0);
+
 	// SDL Window - Init 
 	// Window size  :1024 * 768
 	display = SDL_CreateWindow("LD32 - Eraser",
 			SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
-		       	1024, 768, SDL_WINDOW_OPENGL);
+		       	1024, 768, is_dirty_mode ? 0 : SDL_WINDOW_OPENGL);
 	
 	// SDL Window - Verify
 	if(display == nullptr)
@@ -40,7 +60,12 @@ bool GameWindow::init()
 	}
 
 	// SDL Renderer - Init and verify
-	renderer = SDL_CreateRenderer(display, -1, 0);	
+	Uint32 renderer_flags = is_dirty_mode ? SDL_RENDERER_SOFTWARE : 0;
+	if(is_vsync)
+	{
+		renderer_flags |= SDL_RENDERER_PRESENTVSYNC;
+	}
+	renderer = SDL_CreateRenderer(display, -1, renderer_flags);	
 	if(renderer == nullptr)
 	{
 		// WINDOW 
@@ -48,6 +73,25 @@ bool GameWindow::init()
 		return false;
 	}
 
+	// SDL Renderer - Paced by the timer if the vsync is not available
+	SDL_RendererInfo renderer_info;
+	if(is_vsync && (SDL_GetRendererInfo(renderer, &renderer_info) < 0 || (renderer_info.flags & SDL_RENDERER_PRESENTVSYNC) == 0))
+	{
+		std::cout << "No vsync, frames paced by the timer" << std::endl;
+		is_vsync = false;
+	}
+
+	if(is_dirty_mode)
+	{
+		std::cout << "Dirty rects presentation (software renderer)" << std::endl;
+	}
+
+	// SDL_Image - Init the PNG decoder before levels are decoded on the worker thread
+	if((IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG) == 0)
+	{
+		return false;
+	}
+
 	// SDL_Mixer - Init and verify
 	if(Mix_OpenAudio(44100, AUDIO_S16SYS, 2, 1024) < 0)
 	{
@@ -75,6 +119,22 @@ bool GameWindow::init()
 		// SDL - Free path pointer
 		SDL_free(path);
 	}
+
+	// Game files - Map the archive
+	// (loose files under assets/ and data/ without it)
+	if(!assets.mount(base_path, "eraser.pak"))
+	{
+		std::cout << "No asset archive, using loose files" << std::endl;
+	}
+	vfs.mount("assets/", &assets, "assets/", true);
+	vfs.mount("data/", &assets, "data/", true);
+
+	// Game files - Override pack (mounted above the base files)
+	if(override_assets.mount(base_path, "override.pak"))
+	{
+		std::cout << "Using override archive" << std::endl;
+		vfs.mount("", &override_assets, "", false);
+	}
 	
 	return true;
 }
@@ -95,21 +155,44 @@ bool GameWindow::run()
 		return false;
 	}
 	
+	// Decode pool - One worker per core, decoded images cached in the renderer format
+	if(!pixel_cache.init(renderer, &vfs))
+	{
+		std::cout << "Pixel cache disabled" << std::endl;
+	}
+	decoder.start(&vfs, &pixel_cache);
+
+	// Startup images - Decoded together on the pool
+	Uint32 decode_start = SDL_GetTicks();
+	std::vector<AssetId> startup_ids = {
+		vfs.intern("assets/eraser.png"),
+		vfs.intern("assets/menu.png"),
+		vfs.intern("assets/bt_sheet.png")
+	};
+	std::vector<SDL_Surface*> startup_images;
+	decoder.decode(startup_ids, startup_images);
+	std::cout << "Startup images decoded in " << SDL_GetTicks() - decode_start << " ms" << std::endl;
+
 	// Loading game objects--
 	// Mouse
-	if(!mouse.load(renderer, base_path))
+	bool is_loaded = mouse.load(renderer, startup_images[0]);
+
+	// Menu
+	is_loaded = is_loaded && menu.load(renderer, startup_images[1], startup_images[2]);
+
+	// Startup images - Clean
+	for(auto lImage : startup_images)
 	{
-		return false;
+		SDL_FreeSurface(lImage);
 	}
 
-	// Menu
-	if(!menu.load(renderer, base_path))
+	if(!is_loaded)
 	{
 		return false;
 	}
 	
 	// Level manager
-	if(!lvl_manager.load_index(renderer, base_path))
+	if(!lvl_manager.load_index(renderer, &vfs, &decoder, &render_queue))
 	{
 		return false;
 	}
@@ -117,19 +200,33 @@ bool GameWindow::run()
 
 	// SDL Event listener--
 	SDL_Event lEvent;
+
+	// Frame pacing - From the first frame
+	pacer.start(frame_rate, is_vsync);
 	
 	// Play 
 	while(is_running)
 	{
+		// Loop state - Time spent from here
+		int loop_state = get_loop_state();
+		Uint64 loop_start = SDL_GetPerformanceCounter();
+		std::clock_t loop_cpu = std::clock();
+
+		// Level clock - Stopped in background
+		lvl_manager.set_paused(loop_state == LOOP_BACKGROUND);
+
 		// Begin 
-		// (with cleaned render)
-		SDL_RenderClear(renderer);
+		// (with cleaned render, the damaged areas are cleared in dirty rects mode)
+		if(!is_dirty_mode)
+		{
+			SDL_RenderClear(renderer);
+		}
 
 		// Not playing ? 
 		if(!is_playing)
 		{
 			// Show menu
-			menu.display(renderer);
+			menu.display(&render_queue);
 		}
 
 		// Playing ?
@@ -138,10 +235,51 @@ bool GameWindow::run()
 			// Show level
 			is_playing = lvl_manager.display(renderer);
 		}
-		
+
+		// Mouse displaying 
+		// (top layer of the render queue)
+		mouse.display(&render_queue);
+
+		// Minimized - Nothing to show
+		// (the whole frame is redrawn once restored)
+		if(is_minimized)
+		{
+			render_queue.clear();
+		}
+
+		// Render commands drawing
+		// (sorted by layer then texture, before the events can release a texture)
+		else if(is_dirty_mode)
+		{
+			// Renderer showing - Only the damaged areas 
+			const std::vector<SDL_Rect>& damage = render_queue.submit_damaged(renderer);
+			if(!damage.empty())
+			{
+				SDL_UpdateWindowSurfaceRects(display, damage.data(), damage.size());
+			}
+		}
+		else
+		{
+			// Renderer showing - In current window
+			render_queue.submit(renderer);
+			SDL_RenderPresent(renderer);
+		}
 
 		// Event listener
-		if(SDL_PollEvent(&lEvent))
+		// (nothing animates: sleep until an event comes, redraw then)
+		int has_event = 0;
+		if(loop_state == LOOP_ACTIVE)
+		{
+			has_event = SDL_PollEvent(&lEvent);
+		}
+		else
+		{
+			has_event = SDL_WaitEventTimeout(&lEvent, (loop_state == LOOP_IDLE) ? IDLE_TIMEOUT : BACKGROUND_TIMEOUT);
+			pacer.resume();
+		}
+
+		// Every pending event
+		while(has_event)
 		{
 			// There is an event
 			on_event(&lEvent);
@@ -172,37 +310,40 @@ bool GameWindow::run()
 				// Level Manager - Get event
 				lvl_manager.on_event(&lEvent);
 			}
+
+			has_event = SDL_PollEvent(&lEvent);
 		}
-		
-		// Mouse displaying 
-		// (in renderer)
-		mouse.display(renderer);
-		
-		// Renderer showing 
-		// (in current window)
-		SDL_RenderPresent(renderer);
 	
-		//Slow down cycles
-		SDL_Delay(16);
+		//Wait for the end of the frame
+		//(also limits the redraws of a moving mouse in the menu, only the active frames are measured)
+		pacer.wait(loop_state == LOOP_ACTIVE);
+
+		// Loop state - Time spent
+		state_wall[loop_state] += (double)(SDL_GetPerformanceCounter() - loop_start) / SDL_GetPerformanceFrequency();
+		state_cpu[loop_state] += (double)(std::clock() - loop_cpu) / CLOCKS_PER_SEC;
 	}
+	pacer.report();
+	report_loop_states();
 
 	//Dispose menu and mouse memory
 	mouse.dispose();
 	menu.dispose();
+	lvl_manager.dispose();
+	decoder.stop();
 
 	//Display the ending screen
 	SDL_RenderClear(renderer);	
-	std::string end_image_path = base_path + "assets/pic_quit.png";
+	std::string end_image_path = "assets/pic_quit.png";
 	
 	// On game
 	if(is_playing)
 	{
 		// End screen image path
-		end_image_path = base_path + "assets/pic_exit.png";
+		end_image_path = "assets/pic_exit.png";
 	}
 	
 	// End screen - Init
-	SDL_Surface* end_image = IMG_Load(end_image_path.c_str());
+	SDL_Surface* end_image = IMG_Load_RW(vfs.open(vfs.intern(end_image_path)), 1);
 	SDL_Texture* end_texture = SDL_CreateTextureFromSurface(renderer, end_image);
 	
 	// End sreen - Verify
@@ -218,10 +359,13 @@ bool GameWindow::run()
 	}
 	
 	// Clean game objects--
+	override_assets.unmount();
+	assets.unmount();
 	SDL_DestroyRenderer(renderer);
 	SDL_DestroyWindow(display);
 	Mix_CloseAudio();
 	TTF_Quit();
+	IMG_Quit();
 	SDL_Quit();
 	
 	// EXIT_SUCCESS
@@ -240,6 +384,67 @@ void GameWindow::on_event(SDL_Event* pEvent)
 		case SDL_QUIT:
 			is_running = false;
 			break;
+		case SDL_WINDOWEVENT:
+			switch(pEvent->window.event)
+			{
+				// Window content lost
+				case SDL_WINDOWEVENT_EXPOSED:
+					render_queue.invalidate();
+					break;
+				// Window state - Low tick rate in background
+				case SDL_WINDOWEVENT_FOCUS_GAINED:
+					has_focus = true;
+					break;
+				case SDL_WINDOWEVENT_FOCUS_LOST:
+					has_focus = false;
+					break;
+				case SDL_WINDOWEVENT_MINIMIZED:
+					is_minimized = true;
+					break;
+				case SDL_WINDOWEVENT_RESTORED:
+					is_minimized = false;
+					render_queue.invalidate();
+					break;
+			}
+			break;
+		case SDL_RENDER_TARGETS_RESET:
+			render_queue.invalidate();
+			break;
 	}
 }	
 
+
+/**
+ * get_loop_state (GameWindow)
+ * \brief Loop state from the game and window states: a played level is paced,
+ *        the static menu waits for the events, an unfocused or minimized window
+ *        ticks slowly (the level is paused)
+ * \return int : loop state (LOOP_*)
+ **/
+int GameWindow::get_loop_state()
+{
+	if(is_minimized || !has_focus)
+	{
+		return LOOP_BACKGROUND;
+	}
+	return is_playing ? LOOP_ACTIVE : LOOP_IDLE;
+}
+
+/**
+ * report_loop_states (GameWindow)
+ * \brief Print the wall and CPU time spent in each loop state
+ * \return void
+ **/
+void GameWindow::report_loop_states()
+{
+	const char* lNames[LOOP_STATES] = {"active", "idle", "background"};
+	for(int lState = 0; lState < LOOP_STATES; lState++)
+	{
+		if(state_wall[lState] <= 0)
+		{
+			continue;
+		}
+		std::cout << "Loop " << lNames[lState] << ": " << state_wall[lState] << " s, CPU "
+			<< state_cpu[lState] << " s (" << (100.0 * state_cpu[lState] / state_wall[lState]) << " %)" << std::endl;
+	}
+}
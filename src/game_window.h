@@ -1,10 +1,17 @@
 #ifndef GAME_WINDOW_H
 #define GAME_WINDOW_H
 
+#include <ctime>
 #include <SDL2/SDL.h>
 #include "menu.h"
 #include "mouse_cursor.h"
 #include "level_manager.h"
+#include "asset_archive.h"
+#include "vfs.h"
+#include "decode_pool.h"
+#include "pixel_cache.h"
+#include "render_queue.h"
+#include "frame_pacer.h"
 
 /**
  * \class GameWindow
@@ -16,10 +23,49 @@ class GameWindow
  		bool is_running;  
 		bool is_playing = false;
 
+		//Software renderer presenting only the damaged areas (ERASER_DIRTY_RECTS=1)
+		bool is_dirty_mode = false;
+
+		//Frame pacing (ERASER_FPS frames per second, on the vsync with ERASER_VSYNC=1)
+		FramePacer pacer;
+		double frame_rate = 60;
+		bool is_vsync = false;
+
+		//Loop states: paced frames while a level is played, blocked on the
+		//events in the static menu, low tick rate and paused level unfocused or minimized
+		static const int LOOP_ACTIVE = 0;
+		static const int LOOP_IDLE = 1;
+		static const int LOOP_BACKGROUND = 2;
+		static const int LOOP_STATES = 3;
+
+		//Longest wait for an event (ms): idle redraw, background tick (10 Hz)
+		static const int IDLE_TIMEOUT = 1000;
+		static const int BACKGROUND_TIMEOUT = 100;
+
+		//Window state (SDL_WINDOWEVENT)
+		bool has_focus = true;
+		bool is_minimized = false;
+
+		//Wall and CPU time spent in each loop state (s)
+		double state_wall[LOOP_STATES] = {0, 0, 0};
+		double state_cpu[LOOP_STATES] = {0, 0, 0};
+
+		//Current loop state
+		int get_loop_state();
+
+		//Print the time spent in each loop state
+		void report_loop_states();
+
 		SDL_Window* display;
 		SDL_Renderer* renderer;
 
 		std::string base_path;
+		AssetArchive assets;
+		AssetArchive override_assets;
+		Vfs vfs;
+		PixelCache pixel_cache;
+		DecodePool decoder;
+		RenderQueue render_queue;
 		Menu menu;
 		MouseCursor mouse;
 		LevelManager lvl_manager;
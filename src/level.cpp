@@ -2,25 +2,70 @@
 #include <iostream>
 
 /**
- * load
- * \param SDL_Rendered* 
- * \brief Load the level
- * \return boolean : load level status
+ * prepare
+ * \brief Parse the map and decode the images of the level
+ *        (no renderer work, the level can be prepared on a worker thread)
+ * \return boolean : prepare level status
  **/
-bool Level::load(SDL_Renderer* pRenderer)
+bool Level::prepare()
 {
+	//Resolve the sprite sheets into the atlas when it has been packed
+	lvl_textures.load_atlas(lvl_assets->atlas_index, lvl_assets->atlas_image, lvl_assets->path);
+
 	//Initialize the background image	
-	bg_image = IMG_Load((lvl_bg_path).c_str());
+	lvl_textures.acquire(lvl_bg_id);
+
+	//Initialize the ground image
+	lvl_textures.acquire(lvl_assets->ground);
 
-	txt_font = TTF_OpenFont((lvl_asset_path + "ThinPencilHandwriting.ttf").c_str(), 40);
-	if(!txt_font)
+	init_rects();
+
+	//Load the map
+	if(!load_map(lvl_map_id))
 	{
-		std::cerr << "Cannot load the font" << std::endl;
+		std::cerr << "Cannot load level map: " + lvl_vfs->get_name(lvl_map_id) << std::endl;
+		return false;
 	}
 
-	//Initialize the ground image
-	ground_image = IMG_Load((lvl_asset_path + "ground.png").c_str());
+	//Decode the sprite sheets of the level concurrently
+	if(!lvl_textures.decode())
+	{
+		return false;
+	}
+
+	is_prepare = true;
+
+	return true;
+}
+
+/**
+ * load_headless
+ * \brief Load the map only: no image, no texture and no music, the level
+ *        can be updated without a window nor an audio device
+ * \return boolean : load level status
+ **/
+bool Level::load_headless()
+{
+	init_rects();
+
+	if(!load_map(lvl_map_id))
+	{
+		std::cerr << "Cannot load level map: " + lvl_vfs->get_name(lvl_map_id) << std::endl;
+		return false;
+	}
+
+	is_load = true;
+
+	return true;
+}
 
+/**
+ * init_rects
+ * \brief Initialize the background and the ground sprite rects
+ * \return void
+ **/
+void Level::init_rects()
+{
 	//Initialize the bg sprite
 	bg_rect.w = 1024;
 	bg_rect.h = 768;
@@ -32,11 +77,18 @@ bool Level::load(SDL_Renderer* pRenderer)
 	sprite_rect.h = 16;
 	sprite_rect.x = 0;
 	sprite_rect.y = 0;
+}
 
-	//Load the map
-	if(!load_map(lvl_map_path))
+/**
+ * load
+ * \param SDL_Rendered* 
+ * \brief Load the level (only the texture upload is left if it was prepared)
+ * \return boolean : load level status
+ **/
+bool Level::load(SDL_Renderer* pRenderer)
+{
+	if(!is_prepare && !prepare())
 	{
-		std::cerr << "Cannot load level map: " + lvl_map_path << std::endl;
 		return false;
 	}
 
@@ -47,44 +99,9 @@ bool Level::load(SDL_Renderer* pRenderer)
 		return false;
 	}
 
-	//Initialize the music
-	lvl_music = Mix_LoadMUS((lvl_asset_path + "sfx/music.ogg").c_str());
-	if(!lvl_music)
-	{
-		std::cerr << "Cannot load music" << std::endl;
-		return false;
-	}
-
-	//Initialize the eraser sound
-	sfx_eraser = Mix_LoadWAV((lvl_asset_path + "sfx/eraser.wav").c_str());
-	if(sfx_eraser == nullptr)
-	{
-		std::cerr << "Cannot load sound eraser" << std::endl;  
-		return false;
-	}
-	Mix_VolumeChunk(sfx_eraser, 60);
-
-	//Initialize the die sound
-	sfx_die_splash = Mix_LoadWAV((lvl_asset_path + "sfx/dead_splash.wav").c_str());
-	if(sfx_die_splash == nullptr)
-	{
-		std::cerr << "Cannot load sound die splash" << std::endl;  
-		return false;
-	}
-	Mix_VolumeChunk(sfx_die_splash, 20);
-
-	//Initialize get time sound
-	sfx_get_time = Mix_LoadWAV((lvl_asset_path + "sfx/timer.wav").c_str());
-	if(sfx_get_time == nullptr)
-	{
-		std::cerr << "Cannot load sound get time" << std::endl;  
-		return false;
-	}
-	Mix_VolumeChunk(sfx_get_time, 20);
-
 	is_load = true;
 
-	//Play background music
+	//Play background music (it keeps streaming from the previous level)
 	play_bg_music();
 
 	return true;
@@ -97,208 +114,327 @@ bool Level::load(SDL_Renderer* pRenderer)
  **/
 void Level::unload()
 {
-	//Destroy textures
-	SDL_DestroyTexture(bg_texture);
-	SDL_DestroyTexture(ground_texture);
-	SDL_DestroyTexture(lvl_player.get_texture());
-	SDL_DestroyTexture(lvl_door.get_texture());
+	//Stop streaming the chunks
+	if(lvl_loader != nullptr)
+	{
+		lvl_loader->stop();
+		lvl_loader.reset();
+	}
+	requested_chunks.clear();
+	consumed_spawns.clear();
 
-	for(auto &lvl_pencil : lvl_pencils)
+	//The next update starts the clock again
+	is_clock_started = false;
+	step_lag = 0;
+
+	//Destroy textures (each shared sheet is freed once)
+	lvl_textures.clear();
+
+
+	if(static_texture != nullptr)
 	{
-		SDL_DestroyTexture(lvl_pencil.get_texture());
+		SDL_DestroyTexture(static_texture);
+		static_texture = nullptr;
 	}
+	is_static_dirty = true;
+
+	lvl_chunks.clear();
+	lvl_hash.clear();
+	lvl_player.reborn();
+
+	is_prepare = false;
+	is_load = false;
+}
 
-	for(auto &lvl_spike : lvl_spikes)
+/**
+ * load_map
+ * \param pMapId (AssetId) : Map file
+ * \brief load the level map (chunked map streamed around the player, compiled
+ *        by levelc, the text map as fallback)
+ * \return boolean : load level status
+ **/
+bool Level::load_map(AssetId pMapId)
+{
+	//Chunked map: only the chunks around the player are loaded
+	AssetId lChunksId = lvl_vfs->intern(lvl_vfs->get_name(pMapId) + ".chunks");
+	if(lvl_vfs->exists(lChunksId))
 	{
-		SDL_DestroyTexture(lvl_spike.get_texture());
+		return load_chunked_map(lChunksId);
 	}
 
-	for(auto &lvl_plant : lvl_plants)
+	LevelMap lMap;
+	bool lStatus{false};
+
+	//Compiled map: read in place when it is in the archive
+	AssetId lBinId = lvl_vfs->intern(lvl_vfs->get_name(pMapId) + ".bin");
+	Uint32 lSize{0};
+	const Uint8* lData = lvl_vfs->map(lBinId, &lSize);
+	std::string lvl_content;
+	if(lData != nullptr)
 	{
-		SDL_DestroyTexture(lvl_plant.get_texture());
+		lStatus = lMap.parse_binary(lData, lSize);
+	}
+	else if(lvl_vfs->read(lBinId, lvl_content))
+	{
+		lStatus = lMap.parse_binary((const Uint8*)lvl_content.data(), lvl_content.size());
+	}
+	else if(lvl_vfs->read(pMapId, lvl_content))
+	{
+		lStatus = lMap.parse_text(lvl_content);
+	}
+	else
+	{
+		return false;
 	}
 
-	for(auto &lvl_arachne : lvl_arachnes)
+	for(auto &lError : lMap.errors)
 	{
-		SDL_DestroyTexture(lvl_arachne.get_texture());
+		std::cerr << lvl_vfs->get_name(pMapId) + ": " + lError << std::endl;
 	}
 
-	for(auto &lvl_ghost : lvl_ghosts)
+	if(!lStatus)
 	{
-		SDL_DestroyTexture(lvl_ghost.get_texture());
+		return false;
 	}
 
-	for(auto &lvl_tbonus : lvl_tbonuses)
+	map_rect = {0, 0, lMap.width * LevelMap::TILE_SIZE, lMap.height * LevelMap::TILE_SIZE};
+	lvl_camera.set_bounds(map_rect);
+
+	//Every chunk of the map (resident until unload)
+	std::map<Uint64, ChunkData> lChunks;
+	for(auto &lRect : lMap.ground)
 	{
-		SDL_DestroyTexture(lvl_tbonus.get_texture());
+		int lX = ChunkFile::chunk_of(lRect.x / LevelMap::TILE_SIZE);
+		int lY = ChunkFile::chunk_of(lRect.y / LevelMap::TILE_SIZE);
+		ChunkData& lChunk = lChunks[make_key(lX, lY)];
+		lChunk.x = lX;
+		lChunk.y = lY;
+		lChunk.ground.push_back(lRect);
 	}
 
-	for(auto &lvl_monster : lvl_monsters)
+	for(auto &lEntity : lMap.entities)
 	{
-		lvl_monster.dispose();
+		if(lEntity.type == 'P')
+		{
+			lvl_player = Player(lEntity.x, lEntity.y);
+			lvl_textures.acquire(lvl_assets->player);
+			continue;
+		}
+
+		int lKind = EntityStore::kind_of(lEntity.type);
+		if(lKind < 0)
+		{
+			continue;
+		}
+		lvl_textures.acquire(get_kind_asset(lKind));
+
+		int lX = ChunkFile::chunk_of(lEntity.x);
+		int lY = ChunkFile::chunk_of(lEntity.y);
+		ChunkData& lChunk = lChunks[make_key(lX, lY)];
+		lChunk.x = lX;
+		lChunk.y = lY;
+		lChunk.entities.push_back(lEntity);
 	}
 
-	//Stop music
-	Mix_HaltMusic();
-	Mix_FreeMusic(lvl_music);
+	for(auto &lChunk : lChunks)
+	{
+		add_chunk(lChunk.second);
+	}
 
-	//Free sounds
-	Mix_FreeChunk(sfx_eraser);
-	Mix_FreeChunk(sfx_die_splash);
-	Mix_FreeChunk(sfx_get_time);
+	//First view (the static layer can be composed before the first frame)
+	lvl_camera.follow(*lvl_player.get_rect());
 
-	TTF_CloseFont(txt_font);
-	SDL_DestroyTexture(timer_texture);
+	return true;
+}
 
-	lvl_ground.clear();
-	lvl_player.reborn();
+/**
+ * load_chunked_map
+ * \param pChunksId : Chunked map file (levelc)
+ * \brief Open a chunked map and load the chunks around the player start
+ *        (every sheet is taken: any chunk can hold any entity)
+ * \return boolean : load level status
+ **/
+bool Level::load_chunked_map(AssetId pChunksId)
+{
+	lvl_loader = std::make_shared<ChunkLoader>();
+	if(!lvl_loader->start(lvl_vfs->open(pChunksId)))
+	{
+		std::cerr << lvl_vfs->get_name(pChunksId) + ": invalid chunked map" << std::endl;
+		lvl_loader.reset();
+		return false;
+	}
 
-	is_load = false;
+	map_rect = {0, 0, lvl_loader->get_width() * LevelMap::TILE_SIZE, lvl_loader->get_height() * LevelMap::TILE_SIZE};
+	lvl_camera.set_bounds(map_rect);
+
+	lvl_player = Player(lvl_loader->get_player_x(), lvl_loader->get_player_y());
+
+	lvl_textures.acquire(lvl_assets->player);
+	for(int lKind = 0; lKind < EntityStore::KINDS; lKind++)
+	{
+		lvl_textures.acquire(get_kind_asset(lKind));
+	}
+
+	stream_chunks();
+
+	lvl_camera.follow(*lvl_player.get_rect());
+
+	return true;
+}
+
+/**
+ * find_chunk
+ * \param pX : Chunk X (chunks)
+ * \param pY : Chunk Y (chunks)
+ * \brief Find a resident chunk
+ * \return LevelChunk* : chunk (nullptr if it is not loaded)
+ **/
+LevelChunk* Level::find_chunk(int pX, int pY)
+{
+	auto lIt = lvl_chunks.find(make_key(pX, pY));
+	return (lIt != lvl_chunks.end()) ? &lIt->second : nullptr;
 }
 
 /**
- * add_rect
- * \param pX (int) : Position X
- * \param pY (int) : Position Y
- * \brief Add rect to lvl_ground vector
+ * add_chunk
+ * \param pData : Chunk content
+ * \brief Make a chunk resident: copy its ground and spawn its entities (but
+ *        the ones erased or picked up before it was evicted)
+ * \return void
  **/
-void Level::add_rect(int pX, int pY)
+void Level::add_chunk(const ChunkData& pData)
 {
-	SDL_Rect tmp_rect;
-	tmp_rect.w = 64;
-	tmp_rect.h = 16;
-	tmp_rect.x = pX * 64;
-	tmp_rect.y = pY * 64;
+	LevelChunk& lChunk = lvl_chunks[make_key(pData.x, pData.y)];
+	is_static_dirty = true;
+	lChunk.x = pData.x;
+	lChunk.y = pData.y;
+	lChunk.ground = pData.ground;
+	lChunk.entities.clear(&lvl_hash);
+	lChunk.entities.set_index_key(make_key(pData.x, pData.y));
+
+	//Ground tiles (a ground rect is the top of its tile)
+	SDL_memset(lChunk.ground_rows, 0, sizeof(lChunk.ground_rows));
+	for(auto &lRect : lChunk.ground)
+	{
+		int lRow = tile_at(lRect.y) - pData.y * ChunkFile::CHUNK_TILES;
+		int lColumn = tile_at(lRect.x) - pData.x * ChunkFile::CHUNK_TILES;
+		if(lRow >= 0 && lRow < ChunkFile::CHUNK_TILES && lColumn >= 0 && lColumn < ChunkFile::CHUNK_TILES)
+		{
+			lChunk.ground_rows[lRow] |= (Uint16)(1 << lColumn);
+		}
+	}
 
-	lvl_ground.push_back(tmp_rect);	
+	for(auto &lEntity : pData.entities)
+	{
+		int lKind = EntityStore::kind_of(lEntity.type);
+		if(lKind >= 0 && consumed_spawns.count(make_key(lEntity.x, lEntity.y)) == 0)
+		{
+			lChunk.entities.add(lKind, lEntity.x, lEntity.y, lEntity.x_end, &lvl_hash);
+		}
+	}
 }
 
 /**
- * load_map
- * \param pMapFilepath (std::string) : Map file path
- * \brief load the level map
- * \return boolean : load level status
+ * get_kind_asset
+ * \param pKind : Entity kind
+ * \brief Give the sprite sheet of an entity kind
+ * \return AssetId : sprite sheet
  **/
-bool Level::load_map(std::string pMapFilepath)
+AssetId Level::get_kind_asset(int pKind)
 {
-	bool has_door = false;
-	bool has_player = false;
+	switch(pKind)
+	{
+		case EntityStore::DOOR:
+			return lvl_assets->door;
+		case EntityStore::PENCIL:
+			return lvl_assets->pencil;
+		case EntityStore::SPIKE:
+			return lvl_assets->spike;
+		case EntityStore::PLANT:
+			return lvl_assets->plant;
+		case EntityStore::ARACHNE:
+			return lvl_assets->arachne;
+		case EntityStore::GHOST:
+			return lvl_assets->ghost;
+		case EntityStore::MONSTER:
+			return lvl_assets->monster;
+		default:
+			return lvl_assets->timebonus;
+	}
+}
 
-	std::string lvl_player_path = lvl_asset_path + "playersheet.png";
-	std::string lvl_door_path = lvl_asset_path + "hole.png";
-	std::string lvl_pencil_path = lvl_asset_path + "pencil.png";
-	std::string lvl_spike_path = lvl_asset_path + "spike.png";
-	std::string lvl_plant_path = lvl_asset_path + "plant.png";
-	std::string lvl_arachne_path = lvl_asset_path + "arachne.png";
-	std::string lvl_ghost_path = lvl_asset_path + "ghost.png";
-	std::string lvl_monster_path = lvl_asset_path + "monster.png";
-	std::string lvl_timebonus_path = lvl_asset_path + "timer.png";
+/**
+ * stream_chunks
+ * \brief Take the chunks read in the background, read the chunks next to the
+ *        player now if they are still missing, request the ones a bit further
+ *        and evict the far ones (a map loaded whole is left as is)
+ * \return void
+ **/
+void Level::stream_chunks()
+{
+	if(lvl_loader == nullptr)
+	{
+		return;
+	}
 
-	std::ifstream lvl_file(pMapFilepath);
+	int lChunkSize = ChunkFile::CHUNK_TILES * LevelMap::TILE_SIZE;
+	int lCenterX = chunk_at(lvl_player.get_rect()->x);
+	int lCenterY = chunk_at(lvl_player.get_rect()->y);
 
-	if(lvl_file.is_open())
+	//Read in the background (dropped if the player went away meanwhile, requested
+	//again below if the read failed)
+	ChunkData lData;
+	while(lvl_loader->poll(lData))
 	{
-		std::string line;
-		float line_idx{0};
-		float col_idx{0};
+		requested_chunks.erase(make_key(lData.x, lData.y));
+		if(lData.is_valid && find_chunk(lData.x, lData.y) == nullptr &&
+			SDL_abs(lData.x - lCenterX) <= EVICT_RADIUS && SDL_abs(lData.y - lCenterY) <= EVICT_RADIUS)
+		{
+			add_chunk(lData);
+		}
+	}
 
-		int monster_x1{0};
-		int monster_x2{0};
+	//Evict
+	for(auto lIt = lvl_chunks.begin(); lIt != lvl_chunks.end();)
+	{
+		if(SDL_abs(lIt->second.x - lCenterX) > EVICT_RADIUS || SDL_abs(lIt->second.y - lCenterY) > EVICT_RADIUS)
+		{
+			lIt->second.entities.clear(&lvl_hash);
+			lIt = lvl_chunks.erase(lIt);
+			is_static_dirty = true;
+		}
+		else
+		{
+			lIt++;
+		}
+	}
 
-		while(getline(lvl_file, line))
+	//Load
+	int lChunksX = (map_rect.w + lChunkSize - 1) / lChunkSize;
+	int lChunksY = (map_rect.h + lChunkSize - 1) / lChunkSize;
+	for(int lY = SDL_max(0, lCenterY - PREFETCH_RADIUS); lY <= SDL_min(lChunksY - 1, lCenterY + PREFETCH_RADIUS); lY++)
+	{
+		for(int lX = SDL_max(0, lCenterX - PREFETCH_RADIUS); lX <= SDL_min(lChunksX - 1, lCenterX + PREFETCH_RADIUS); lX++)
 		{
-			for(auto lChar : line)
+			if(find_chunk(lX, lY) != nullptr)
 			{
-				switch(lChar)
+				continue;
+			}
+
+			if(SDL_abs(lX - lCenterX) <= REQUIRED_RADIUS && SDL_abs(lY - lCenterY) <= REQUIRED_RADIUS)
+			{
+				//Needed for the collisions and the view: no wait for the worker
+				if(lvl_loader->load(lX, lY, lData))
 				{
-					case '*': //Ground
-						add_rect(col_idx, line_idx);
-						break;
-					case 'P': //Player
-						has_player = true;
-						lvl_player = Player(lvl_player_path, col_idx, line_idx);
-						break;
-					case 'D': //Door
-						has_door = true;
-						lvl_door = Door(lvl_door_path, col_idx, line_idx);
-						break;
-					case 'A': //Arachnee
-						{
-							Arachne lvl_arachne = Arachne(lvl_arachne_path, col_idx, line_idx);
-							lvl_arachnes.push_back(lvl_arachne);
-						}
-						break;
-					case '[': //Monster start
-						monster_x1 = col_idx;
-						break;
-					case ']': //Monster end
-						monster_x2 = col_idx;
-						break;
-					case 'S': //Spike
-						{
-							Spike lvl_spike = Spike(lvl_spike_path, col_idx, line_idx);
-							lvl_spikes.push_back(lvl_spike);
-						}
-						break;
-					case 'F': //Fleur
-						{
-							Plantivorus lvl_plant = Plantivorus(lvl_plant_path, col_idx, line_idx);
-							lvl_plants.push_back(lvl_plant);
-
-						}
-						break;
-					case 'G': //Ghost
-						{
-							Ghost lvl_ghost = Ghost(lvl_ghost_path, col_idx, line_idx);
-							lvl_ghosts.push_back(lvl_ghost);
-						}
-						break;
-					case 'T': //Time bonus
-						{
-							TimeBonus lvl_tbonus = TimeBonus(lvl_timebonus_path, col_idx, line_idx);
-							lvl_tbonuses.push_back(lvl_tbonus);
-						}
-						break;
-					case 'C': //Crayon
-						{
-							Pencil lvl_pencil = Pencil(lvl_pencil_path, col_idx, line_idx);
-							lvl_pencils.push_back(lvl_pencil);
-						}
-						break;
+					add_chunk(lData);
 				}
-				col_idx++;
 			}
-		
-			if(monster_x1 != monster_x2)
+			else if(requested_chunks.insert(make_key(lX, lY)).second)
 			{
-				Monster lvl_monster = Monster(lvl_monster_path, monster_x1, monster_x2, line_idx);
-			       	lvl_monsters.push_back(lvl_monster);	
+				lvl_loader->request(lX, lY);
 			}
-
-			monster_x1 = 0;
-			monster_x2 = 0;
-			col_idx = 0;
-			line_idx++;
-		}
-		lvl_file.close();
-	
-		if(!has_player)
-		{
-			std::cerr << "There is no player in this level map (" + pMapFilepath + ") !!" << std::endl;
-			return false;
-		}
-
-		if(!has_door)
-		{
-			std::cerr << "There is no exit in this level map (" + pMapFilepath + ") !!" << std::endl;
-			return false;
 		}
 	}
-	else
-	{
-		return false;
-	}
-	return true;
 }
 
 /**
@@ -309,455 +445,571 @@ bool Level::load_map(std::string pMapFilepath)
  **/
 bool Level::init_textures(SDL_Renderer* pRenderer)
 {
-	bg_texture = SDL_CreateTextureFromSurface(pRenderer, bg_image);
-	if(bg_texture <= 0)
+	//One texture per sprite sheet
+	if(!lvl_textures.init_textures(pRenderer))
+	{
+		return false;
+	}
+
+	bg_texture = lvl_textures.get_sheet(lvl_bg_id).texture;
+	if(bg_texture == nullptr)
 	{
 		std::cerr << "Invalid background texture" << std::endl;
 		return false;
 	}
-	SDL_FreeSurface(bg_image);
 	
-	ground_texture = SDL_CreateTextureFromSurface(pRenderer, ground_image);
-	if(ground_texture <= 0)
+	ground_sheet = lvl_textures.get_sheet(lvl_assets->ground);
+	if(ground_sheet.texture == nullptr)
 	{
 		std::cerr << "Invalid ground texture" << std::endl;
 		return false;
 	}
-	SDL_FreeSurface(ground_image);
 
-	for(auto &lvl_pencil : lvl_pencils)
+	for(int lKind = 0; lKind < EntityStore::KINDS; lKind++)
 	{
-		if(!lvl_pencil.init_texture(pRenderer))
-		{
-			std::cerr << "Invalid pencil texture" << std::endl;
-			return false;
-		}
+		entity_sheets[lKind] = lvl_textures.get_sheet(get_kind_asset(lKind));
 	}
 
-	for(auto &lvl_spike : lvl_spikes)
+	//Every spawned entity is drawn from its kind sheet
+	for(auto &lChunk : lvl_chunks)
 	{
-		if(!lvl_spike.init_texture(pRenderer))
+		const EntityStore& lEntities = lChunk.second.entities;
+		for(size_t lIdx = 0; lIdx < lEntities.size(); lIdx++)
 		{
-			std::cerr << "Invalid spike texture" << std::endl;
-			return false;
+			if(entity_sheets[lEntities.get_kind(lIdx)].texture == nullptr)
+			{
+				std::cerr << "Invalid entity texture" << std::endl;
+				return false;
+			}
 		}
 	}
 
-	for(auto &lvl_plant : lvl_plants)
+	if(!lvl_player.init_texture(lvl_textures.get_sheet(lvl_assets->player)))
 	{
-		if(!lvl_plant.init_texture(pRenderer))
-		{
-			std::cerr << "Invalid plantivorus texture" << std::endl;
-			return false;
-		}
+		std::cerr << "Invalid player texture" << std::endl;
+		return false;
 	}
 
-	for(auto &lvl_arachne : lvl_arachnes)
+	return true;
+}
+
+/**
+ * build_static_layer
+ * \param pRenderer : Game renderer
+ * \brief Compose the background and the ground tiles of the view into a target texture
+ * \return boolean : build status (false if render targets are not supported)
+ **/
+bool Level::build_static_layer(SDL_Renderer* pRenderer)
+{
+	if(!SDL_RenderTargetSupported(pRenderer))
 	{
-		if(!lvl_arachne.init_texture(pRenderer))
-		{
-			std::cerr << "Invalid arachne texture" << std::endl;
-			return false;
-		}
+		return false;
 	}
 
-	for(auto &lvl_ghost : lvl_ghosts)
+	if(static_texture == nullptr)
 	{
-		if(!lvl_ghost.init_texture(pRenderer))
+		static_texture = SDL_CreateTexture(pRenderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, bg_rect.w, bg_rect.h);
+		if(static_texture == nullptr)
 		{
-			std::cerr << "Invalid ghost texture" << std::endl;
+			std::cerr << "Cannot create the static layer: " << SDL_GetError() << std::endl;
 			return false;
 		}
+
+		//Opaque layer : copied without blending
+		SDL_SetTextureBlendMode(static_texture, SDL_BLENDMODE_NONE);
 	}
 
-	for(auto &lvl_monster : lvl_monsters)
+	SDL_Texture* lTarget = SDL_GetRenderTarget(pRenderer);
+	if(SDL_SetRenderTarget(pRenderer, static_texture) < 0)
 	{
-		if(!lvl_monster.init_texture(pRenderer))
-		{
-			std::cerr << "Invalid monster texture" << std::endl;
-			return false;
-		}
+		return false;
 	}
 
-	for(auto &lvl_tbonus : lvl_tbonuses)
+	SDL_RenderClear(pRenderer);
+
+	//Background tiles and ground in the view, moved to the layer origin
+	const SDL_Rect& lView = lvl_camera.get_view();
+	for(int lY = lView.y / bg_rect.h * bg_rect.h; lY < lView.y + lView.h; lY += bg_rect.h)
 	{
-		if(!lvl_tbonus.init_texture(pRenderer))
+		for(int lX = lView.x / bg_rect.w * bg_rect.w; lX < lView.x + lView.w; lX += bg_rect.w)
 		{
-			std::cerr << "Invalid time bonus texture" << std::endl;
-			return false;
+			SDL_Rect lDst = {lX - lView.x, lY - lView.y, bg_rect.w, bg_rect.h};
+			SDL_RenderCopy(pRenderer, bg_texture, &bg_rect, &lDst);
 		}
 	}
 
-	if(!lvl_door.init_texture(pRenderer))
+	SDL_Rect lGroundSrc = ground_sheet.frame(sprite_rect);
+	for(auto &lChunk : lvl_chunks)
 	{
-		std::cerr << "Invalid door texture" << std::endl;
-		return false;
+		for(auto &lGroundRect : lChunk.second.ground)
+		{
+			if(lvl_camera.is_visible(lGroundRect))
+			{
+				SDL_Rect lDst = {lGroundRect.x - lView.x, lGroundRect.y - lView.y, lGroundRect.w, lGroundRect.h};
+				SDL_RenderCopy(pRenderer, ground_sheet.texture, &lGroundSrc, &lDst);
+			}
+		}
 	}
 
-	if(!lvl_player.init_texture(pRenderer))
-	{
-		std::cerr << "Invalid player texture" << std::endl;
-		return false;
-	}
+	SDL_SetRenderTarget(pRenderer, lTarget);
+	static_view = lView;
+	is_static_dirty = false;
 
 	return true;
 }
 
 /**
- * play_bg_music
- * \brief Launch the music
+ * update_static_layer
+ * \param pRenderer : Game renderer (nullptr without window, nothing is composed)
+ * \brief Compose the static layer if it is dirty (dropped if it cannot be composed)
  * \return void
  **/
-void Level::play_bg_music()
+void Level::update_static_layer(SDL_Renderer* pRenderer)
 {
-	Mix_PlayMusic(lvl_music, -1);
-	Mix_VolumeMusic(15);
+	if(pRenderer != nullptr && is_static_dirty && !build_static_layer(pRenderer) && static_texture != nullptr)
+	{
+		SDL_DestroyTexture(static_texture);
+		static_texture = nullptr;
+	}
 }
 
 /**
- * check_ground_collision
- * \brief Check for collision with a given SDL_Rect
- * \return boolean : collision status
+ * render_static_layer
+ * \param pRenderer : Game renderer
+ * \brief Add the background and the ground of the view to the frame renderer
+ *        (one copy of the static layer, or every tile when render targets are
+ *        not supported), only change the stamp when the render thread composes it
+ * \return void
  **/
-bool Level::check_ground_collision()
+void Level::render_static_layer(SDL_Renderer* pRenderer)
 {
-	for(auto lGroundRect : lvl_ground)
+	//Composed for another view
+	if(!SDL_RectEquals(&static_view, &lvl_camera.get_view()))
 	{
-		if(SDL_HasIntersection(lvl_player.get_rect(), &lGroundRect))
-		{
-			return true;			
-		}
+		is_static_dirty = true;
 	}
-	return false;
-}
 
-/**
- * check_time_bonus_collision
- * \brief Check for collision with timer bonuses
- * \return int : collision status
- **/
-int Level::check_time_bonus_collision()
-{
-	int cpt{0};
-	int idx{-1};
-	
-	for(auto &lvl_tbonus : lvl_tbonuses)
+	//The tiles are sent again by the simulation thread when the stamp changes
+	if(is_static_remote)
 	{
-		if(SDL_HasIntersection(lvl_player.get_rect(), lvl_tbonus.get_rect()))
+		if(is_static_dirty)
 		{
-			idx = cpt;			
+			static_view = lvl_camera.get_view();
+			is_static_dirty = false;
+			static_stamp++;
 		}
-		cpt++;
+		return;
 	}
-	return idx;
-}
-
 
-/**
- * check_danger_collision
- * \brief Check collisions with dangerous things
- * \return boolean : collision status
- **/
-bool Level::check_danger_collision()
-{
-	//Check pencils
-	for(auto &lvl_spike : lvl_spikes)
+	//Re-composed: same command, new content (the damaged areas only come from the commands)
+	bool lWasDirty = is_static_dirty;
+	update_static_layer(pRenderer);
+	if(lWasDirty && !is_static_dirty && static_texture != nullptr)
 	{
-		if(SDL_HasIntersection(lvl_player.get_rect(), lvl_spike.get_rect()))
-		{
-			return true;			
-		}
+		lvl_camera.invalidate();
 	}
 
-	//Check with plantivorus
-	for(auto &lvl_plant : lvl_plants)
+	//One copy of the composed layer, every tile while its content is lost
+	if(static_texture != nullptr && !is_static_dirty)
 	{
-		if(SDL_HasIntersection(lvl_player.get_rect(), lvl_plant.get_rect()))
-		{
-			return true;			
-		}
+		lvl_camera.push(GameRenderer::LAYER_BACKGROUND, static_texture, bg_rect, static_view);
+		return;
 	}
 
-	//Check with ghost
-	for(auto &lvl_ghost : lvl_ghosts)
+	render_tiles();
+}
+
+/**
+ * render_tiles
+ * \brief Add the background tiles (the image repeated over the map) and the
+ *        ground in the view to the frame renderer
+ * \return void
+ **/
+void Level::render_tiles()
+{
+	const SDL_Rect& lView = lvl_camera.get_view();
+	for(int lY = lView.y / bg_rect.h * bg_rect.h; lY < lView.y + lView.h; lY += bg_rect.h)
 	{
-		if(SDL_HasIntersection(lvl_player.get_rect(), lvl_ghost.get_rect()))
+		for(int lX = lView.x / bg_rect.w * bg_rect.w; lX < lView.x + lView.w; lX += bg_rect.w)
 		{
-			return true;			
+			lvl_camera.push(GameRenderer::LAYER_BACKGROUND, bg_texture, bg_rect, {lX, lY, bg_rect.w, bg_rect.h});
 		}
 	}
 
-	//Check with arachne
-	for(auto &lvl_arachne : lvl_arachnes)
+	SDL_Rect lGroundSrc = ground_sheet.frame(sprite_rect);
+	for(auto &lChunk : lvl_chunks)
 	{
-		if(SDL_HasIntersection(lvl_player.get_rect(), lvl_arachne.get_rect()))
+		for(auto &lGroundRect : lChunk.second.ground)
 		{
-			return true;			
+			lvl_camera.push(GameRenderer::LAYER_GROUND, ground_sheet.texture, lGroundSrc, lGroundRect);
 		}
 	}
+}
+
+/**
+ * play_bg_music
+ * \brief Launch the music
+ * \return void
+ **/
+void Level::play_bg_music()
+{
+	lvl_audio->play_music(15);
+}
 
-	//Check with monster
-	for(auto &lvl_monster : lvl_monsters)
+/**
+ * has_ground
+ * \param pTileX : Tile X
+ * \param pTileY : Tile Y
+ * \brief Check the ground bit of a tile
+ * \return boolean : ground status (false if its chunk is not loaded)
+ **/
+bool Level::has_ground(int pTileX, int pTileY)
+{
+	int lChunkX = ChunkFile::chunk_of(pTileX);
+	int lChunkY = ChunkFile::chunk_of(pTileY);
+	LevelChunk* lChunk = find_chunk(lChunkX, lChunkY);
+	if(lChunk == nullptr)
 	{
-		if(SDL_HasIntersection(lvl_player.get_rect(), lvl_monster.get_rect()))
-		{
-			return true;
-		}
+		return false;
 	}
 
-	return false;
+	int lRow = pTileY - lChunkY * ChunkFile::CHUNK_TILES;
+	int lColumn = pTileX - lChunkX * ChunkFile::CHUNK_TILES;
+	return ((lChunk->ground_rows[lRow] >> lColumn) & 1) != 0;
 }
 
 /**
- * check_door_collision
- * \brief Check if player collides with the door
+ * check_ground_collision
+ * \brief Check for collision with the ground: a bit test per tile whose
+ *        ground (the top of the tile) the player rect covers
  * \return boolean : collision status
  **/
-bool Level::check_door_collision()
+bool Level::check_ground_collision()
 {
-	SDL_Rect* lRect = lvl_door.get_rect();
-	if(SDL_HasIntersection(lvl_player.get_rect(), lRect))
+	SDL_Rect* lRect = lvl_player.get_rect();
+	for(int lY = tile_at(lRect->y - LevelMap::GROUND_HEIGHT) + 1; lY <= tile_at(lRect->y + lRect->h - 1); lY++)
 	{
-		return true;
+		for(int lX = tile_at(lRect->x); lX <= tile_at(lRect->x + lRect->w - 1); lX++)
+		{
+			if(has_ground(lX, lY))
+			{
+				return true;
+			}
+		}
 	}
 	return false;
 }
 
 /**
- * refresh_timer
- * \param pRendered : Game renderer
- * \return void
+ * check_map_bounds
+ * \brief Check if the player is inside the map
+ * \return boolean : inside status
  **/
-void Level::refresh_timer(SDL_Renderer* pRenderer)
+bool Level::check_map_bounds()
 {
-	std::string current_txt = std::to_string(available_time);
-
-	SDL_Surface* txt_image = TTF_RenderText_Blended_Wrapped(txt_font, current_txt.c_str(), txt_color, bg_rect.w - 5);
-	timer_texture = SDL_CreateTextureFromSurface(pRenderer, txt_image);
-	SDL_FreeSurface(txt_image);
-	
-	int lWidth{0};
-	int lHeight{0};
-	SDL_QueryTexture(timer_texture, nullptr, nullptr, &lWidth, &lHeight);
-	
-	timer_rect.w = lWidth;
-	timer_rect.h = lHeight;
-	timer_rect.x = 0;
-	timer_rect.y = 0;
-
-	timer_pos_rect.w = timer_rect.w;
-	timer_pos_rect.h = timer_rect.h;
-	timer_pos_rect.x = 5*bg_rect.w/6 + 80;
-	timer_pos_rect.y = 5;
+	SDL_Rect* lRect = lvl_player.get_rect();
+	return lRect->x >= map_rect.x && lRect->y >= map_rect.y &&
+		lRect->x + lRect->w <= map_rect.x + map_rect.w &&
+		lRect->y + lRect->h <= map_rect.y + map_rect.h;
 }
 
 /**
- * display_no_more_time
- * \param pRendered : Game renderer
- * \brief Display the time's up picture
+ * release_texture
+ * \param pAsset : Sprite sheet of a removed entity
+ * \brief Release the sheet of a removed entity (kept while the map is streamed:
+ *        the chunks loaded later need it)
  * \return void
  **/
-void Level::display_no_more_time(SDL_Renderer* pRenderer)
+void Level::release_texture(AssetId pAsset)
 {
-	SDL_RenderClear(pRenderer);	
-	std::string image_path = lvl_asset_path + "pic_notime.png";
-	SDL_Surface* image = IMG_Load(image_path.c_str());
-	SDL_Texture* texture = SDL_CreateTextureFromSurface(pRenderer, image);
-	if(texture > 0)
+	if(lvl_loader == nullptr)
 	{
-		SDL_FreeSurface(image);
-		SDL_RenderCopy(pRenderer, texture, nullptr, nullptr);
-		SDL_RenderPresent(pRenderer);
-		
-		//Slow down cycles
-		SDL_Delay(2000);
+		lvl_textures.release(pAsset);
 	}
 }
 
 /**
- * display_fail
- * \param pRenderer : Game renderer
- * \brief Display failure message
- * \return void
+ * take_time_bonus
+ * \brief Pick up a time bonus under the player (not spawned again)
+ * \return boolean : pick up status
  **/
-void Level::display_fail(SDL_Renderer* pRenderer)
+bool Level::take_time_bonus()
 {
-	SDL_RenderClear(pRenderer);	
-	std::string image_path = lvl_asset_path + "pic_fail.png";
-	SDL_Surface* image = IMG_Load(image_path.c_str());
-	SDL_Texture* texture = SDL_CreateTextureFromSurface(pRenderer, image);
-	if(texture > 0)
+	size_t lIdx;
+	LevelChunk* lChunk = find_entity(*lvl_player.get_rect(), 1 << EntityStore::TIME_BONUS, &lIdx);
+	if(lChunk == nullptr)
 	{
-		SDL_FreeSurface(image);
-		SDL_RenderCopy(pRenderer, texture, nullptr, nullptr);
-		SDL_RenderPresent(pRenderer);
-		
-		//Slow down cycles
-		SDL_Delay(2000);
+		return false;
 	}
+
+	remove_entity(*lChunk, lIdx);
+	return true;
 }
 
 /**
- * render level
- * \param pRenderer : Game renderer
- * \brief Render the texture through given renderer
- * \return boolean : level render status
+ * find_entity
+ * \param pRect : Area (pixels)
+ * \param pKindMask : Kinds to look for (1 << kind)
+ * \param pIdx : Entity index in its chunk (output)
+ * \brief Find an entity of the masked kinds intersecting an area, only in
+ *        the spatial hash cells of the area
+ * \return LevelChunk* : chunk of the entity (nullptr if none)
  **/
-bool Level::render(SDL_Renderer* pRenderer)
+LevelChunk* Level::find_entity(const SDL_Rect& pRect, Uint32 pKindMask, size_t* pIdx)
 {
-	SDL_RenderCopy(pRenderer, bg_texture, &bg_rect, &bg_rect);
+	found_entities.clear();
+	lvl_hash.query(pRect, found_entities);
 
-	for(auto lGroundRect : lvl_ground)
-	{	
-		SDL_RenderCopy(pRenderer, ground_texture, &sprite_rect, &lGroundRect);
-	}
-
-	for(auto &lvl_pencil : lvl_pencils)
+	for(auto &lEntry : found_entities)
 	{
-		lvl_pencil.render(pRenderer);
+		auto lChunk = lvl_chunks.find(lEntry.chunk);
+		if(lChunk != lvl_chunks.end() && lChunk->second.entities.is_hit(lEntry.index, pRect, pKindMask))
+		{
+			*pIdx = lEntry.index;
+			return &lChunk->second;
+		}
 	}
+	return nullptr;
+}
 
-	for(auto &lvl_spike : lvl_spikes)
-	{
-		lvl_spike.render(pRenderer);
-	}
+/**
+ * remove_entity
+ * \param pChunk : Chunk of the entity
+ * \param pIdx : Entity index in the chunk
+ * \brief Remove an erased or picked up entity: it is not spawned again when
+ *        its chunk is reloaded
+ * \return void
+ **/
+void Level::remove_entity(LevelChunk& pChunk, size_t pIdx)
+{
+	const SDL_Point& lSpawn = pChunk.entities.get_spawn(pIdx);
+	consumed_spawns.insert(make_key(lSpawn.x, lSpawn.y));
+	release_texture(get_kind_asset(pChunk.entities.get_kind(pIdx)));
+	pChunk.entities.remove(pIdx, &lvl_hash);
+}
 
-	for(auto &lvl_plant : lvl_plants)
-	{
-		lvl_plant.render(pRenderer);
-	}
 
-	for(auto &lvl_arachne : lvl_arachnes)
-	{
-		lvl_arachne.render(pRenderer);
-	}
+/**
+ * check_danger_collision
+ * \brief Check collisions with dangerous things
+ * \return boolean : collision status
+ **/
+bool Level::check_danger_collision()
+{
+	size_t lIdx;
+	return find_entity(*lvl_player.get_rect(), EntityStore::DANGER_MASK, &lIdx) != nullptr;
+}
 
-	for(auto &lvl_ghost : lvl_ghosts)
-	{
-		lvl_ghost.render(pRenderer);
-	}
+/**
+ * check_door_collision
+ * \brief Check if player collides with a door
+ * \return boolean : collision status
+ **/
+bool Level::check_door_collision()
+{
+	size_t lIdx;
+	return find_entity(*lvl_player.get_rect(), 1 << EntityStore::DOOR, &lIdx) != nullptr;
+}
 
-	for(auto &lvl_monster : lvl_monsters)
+/**
+ * refresh_timer
+ * \brief Refresh the timer text (drawn every frame from the glyph atlas)
+ * \return void
+ **/
+void Level::refresh_timer()
+{
+	SDL_snprintf(timer_text, sizeof(timer_text), "%d", available_time);
+
+	timer_pos_rect.x = 5*bg_rect.w/6 + 80;
+	timer_pos_rect.y = 5;
+}
+
+/**
+ * update
+ * \param pTime : Game time (ms, SDL_GetTicks or a simulated clock)
+ * \brief Move the level to the given time in fixed steps: the steps missed
+ *        by a long frame are caught up (MAX_CATCH_UP_STEPS at most), the
+ *        time left is drawn by interpolation
+ * \return int : level state (PLAYING, FINISHED, FAILED or TIME_OUT)
+ **/
+int Level::update(Uint32 pTime)
+{
+	if(!is_clock_started)
 	{
-		lvl_monster.render(pRenderer);
+		last_update = pTime;
+		is_clock_started = true;
+		schedule_events();
 	}
 
-	for(auto &lvl_tbonus : lvl_tbonuses)
+	step_lag += pTime - last_update;
+	last_update = pTime;
+
+	//Hitch: the level slows down instead of jumping ahead
+	if(step_lag > (Uint32)(MAX_CATCH_UP_STEPS * STEP_TIME))
 	{
-		lvl_tbonus.render(pRenderer);
+		step_lag = MAX_CATCH_UP_STEPS * STEP_TIME;
 	}
 
-	lvl_door.render(pRenderer);
-
-	current_time = SDL_GetTicks();
+	//Chunks around the player (a map loaded whole is left as is)
+	stream_chunks();
 
-	if(current_time > next_time_refresh)
+	while(step_lag >= (Uint32)STEP_TIME)
 	{
-		available_time--;
-		if(available_time <= 0)
+		step_lag -= STEP_TIME;
+
+		int lState = step();
+		if(lState != PLAYING)
 		{
-			display_no_more_time(pRenderer);
-			return false;
+			step_alpha = 1.0f;
+			return lState;
 		}
-		refresh_timer(pRenderer);		
-		next_time_refresh = current_time + 1000;
 	}
-	SDL_RenderCopy(pRenderer, timer_texture, &timer_rect, &timer_pos_rect);
 
-	if(current_time > next_fall_down)
+	step_alpha = (float)step_lag / STEP_TIME;
+
+	return PLAYING;
+}
+
+/**
+ * schedule_events
+ * \brief Register the periodic rules (one tick per step): countdown, gravity
+ *        and the steps of every entity kind, its phases spread over the period
+ * \return void
+ **/
+void Level::schedule_events()
+{
+	lvl_timers.clear();
+	lvl_timers.schedule(EVENT_COUNTDOWN, 1, COUNTDOWN_PERIOD / STEP_TIME);
+	lvl_timers.schedule(EVENT_FALL, 1, FALL_PERIOD / STEP_TIME);
+
+	for(int lKind = 0; lKind < EntityStore::KINDS; lKind++)
 	{
-		if(lvl_player.is_jumping())
+		int lPeriod = EntityStore::get_kind_period(lKind) / STEP_TIME;
+		if(lPeriod == 0)
 		{
-			lvl_player.walk();
+			continue;
 		}
-		else
-		{
-			lvl_player.fall(lvl_ground);
-		}
-		next_fall_down = current_time + 80;
-	}
 
-	if(current_time > next_monster_move)
-	{
-		for(auto &lvl_monster : lvl_monsters)
+		for(int lPhase = 0; lPhase < EntityStore::PHASES; lPhase++)
 		{
-			lvl_monster.move();
+			lvl_timers.schedule(EVENT_ENTITY_STEP + lKind * EntityStore::PHASES + lPhase, 1 + lPhase * lPeriod / EntityStore::PHASES, lPeriod);
 		}
-		next_monster_move = current_time + 180;
 	}
+}
 
-	if(current_time > next_spikes_update)
+/**
+ * step
+ * \brief Run one fixed step of the level: the periodic rules due at this
+ *        step (timer wheel), then the collisions
+ * \return int : level state (PLAYING, FINISHED, FAILED or TIME_OUT)
+ **/
+int Level::step()
+{
+	//Positions drawn at the start of the interpolation
+	lvl_player.save_rect();
+	for(auto &lChunk : lvl_chunks)
 	{
-		for(auto &lvl_spike : lvl_spikes)
-		{
-			lvl_spike.switch_spikes();
-		}
-	
-		next_spikes_update = current_time + 210;
+		lChunk.second.entities.save_positions();
 	}
 
-	if(current_time > next_plants_update)
+	if(take_time_bonus())
 	{
-		for(auto &lvl_plant : lvl_plants)
-		{
-			lvl_plant.switch_position();
-		}
-	
-		next_plants_update = current_time + 1000;
+		//Play tic-tac sound
+		lvl_audio->play_sound(lvl_assets->sfx_get_time);
+
+		available_time = available_time + TIME_BONUS_VALUE;
+		refresh_timer();		
 	}
 
-	if(current_time > next_arachnes_update)
+	due_events.clear();
+	lvl_timers.advance(due_events);
+
+	for(int lEvent : due_events)
 	{
-		for(auto &lvl_arachne : lvl_arachnes)
-		{
-			lvl_arachne.switch_position();
-		}
-	
-		for(auto &lvl_ghost : lvl_ghosts)
+		switch(lEvent)
 		{
-			lvl_ghost.switch_position();
+			case EVENT_COUNTDOWN:
+				available_time--;
+				if(available_time <= 0)
+				{
+					return TIME_OUT;
+				}
+				refresh_timer();
+				break;
+			case EVENT_FALL:
+				if(lvl_player.is_jumping())
+				{
+					lvl_player.walk();
+				}
+				else
+				{
+					//The ground and the bottom of the map hold the player
+					lvl_player.move_y(1);
+					if(check_ground_collision() || !check_map_bounds())
+					{
+						lvl_player.move_y(-1);
+					}
+				}
+				break;
+			default:
+				//Monster patrols, spike, plant, arachne and ghost animations
+				for(auto &lChunk : lvl_chunks)
+				{
+					lChunk.second.entities.step((lEvent - EVENT_ENTITY_STEP) / EntityStore::PHASES, (lEvent - EVENT_ENTITY_STEP) % EntityStore::PHASES, &lvl_hash);
+				}
+				break;
 		}
-
-		next_arachnes_update = current_time + 600;
 	}
-	
+
 	//Check if the player collides with dangerous things
 	if(check_danger_collision())
 	{
-		//Play sound only if something erasable is under the eraser
-		Mix_PlayChannel(-1, sfx_die_splash, 0); 
-		SDL_Delay(200);
-		display_fail(pRenderer);
-		return false;
+		lvl_audio->play_sound(lvl_assets->sfx_die_splash);
+		return FAILED;
 	}
 
 	//Check if the player is in front of the door
 	if(check_door_collision())
 	{
 		is_finish = true;
+		finish_counter = SDL_GetPerformanceCounter();
+		return FINISHED;
 	}
 
-	int tbonus_idx = check_time_bonus_collision();
-	if(tbonus_idx > -1)
-	{
-		//Play tic-tac sound
-		Mix_PlayChannel(-1, sfx_get_time, 0); 
+	return PLAYING;
+}
 
-		lvl_tbonuses.erase(lvl_tbonuses.begin() + tbonus_idx);
-		
-		available_time = available_time + TIME_BONUS_VALUE;
-		refresh_timer(pRenderer);		
+/**
+ * render level
+ * \param pRenderer : Game renderer (nullptr without window or on the simulation thread, the static layer is not composed)
+ * \brief Send the render commands of the sprites in the view to the frame renderer
+ * \return void
+ **/
+void Level::render(SDL_Renderer* pRenderer)
+{
+	//Sprites in map coordinates through the view following the player
+	lvl_camera.set_target(lvl_renderer);
+	lvl_camera.follow(lvl_player.get_render_rect(step_alpha));
+
+	render_static_layer(pRenderer);
+
+	//Between the last two steps
+	for(auto &lChunk : lvl_chunks)
+	{
+		lChunk.second.entities.render(&lvl_camera, entity_sheets, step_alpha);
 	}
 
-	lvl_player.render(pRenderer);
-	return true;
+	lvl_renderer->draw_text(timer_text, timer_pos_rect.x, timer_pos_rect.y, txt_color);
+
+	lvl_player.render(&lvl_camera, step_alpha);
 }
 
 /**
  * erase_under 
  * \param pMouseX : Mouse X position
  * \parm pMouseY : Mouse Y position 
- * \brief Erase everything under the eraser (erasing it!)
+ * \brief Erase everything under the eraser (erasing it!), the erased entities
+ *        are not spawned again when their chunk is reloaded
  * \return boolean : erase under status
  **/
 bool Level::erase_under(int pMouseX, int pMouseY)
@@ -768,96 +1020,17 @@ bool Level::erase_under(int pMouseX, int pMouseY)
 	mouse_rect.h = 32;
 	mouse_rect.x = pMouseX;
 	mouse_rect.y = pMouseY;
-	
-	//Test the spikes
-	int cpt = 0;
-	int removal_id = -1;
-	
-	for(auto &lvl_spike : lvl_spikes)
-	{
-		if(SDL_HasIntersection(&mouse_rect, lvl_spike.get_rect()))
-		{
-			removal_id = cpt;			
-		}
-		cpt++;
-	}
-
-	if(removal_id > -1)
-	{
-		lvl_spikes.erase(lvl_spikes.begin() + removal_id);
-		return true;
-	}
 
-	//Test the plantivorus
-	cpt = 0;
-	for(auto &lvl_plant : lvl_plants)
+	//First entity found under the eraser
+	size_t lIdx;
+	LevelChunk* lChunk = find_entity(mouse_rect, EntityStore::ERASABLE_MASK, &lIdx);
+	if(lChunk == nullptr)
 	{
-		if(SDL_HasIntersection(&mouse_rect, lvl_plant.get_rect()))
-		{
-			removal_id = cpt;			
-		}
-		cpt++;
-	}
-
-	if(removal_id > -1)
-	{
-		lvl_plants.erase(lvl_plants.begin() + removal_id);
-		return true;
-	}
-
-	//Test arachnes
-	cpt = 0;
-	for(auto &lvl_arachne : lvl_arachnes)
-	{
-		if(SDL_HasIntersection(&mouse_rect, lvl_arachne.get_rect()))
-		{
-			removal_id = cpt;			
-		}
-		cpt++;
-	}
-
-	if(removal_id > -1)
-	{
-		lvl_arachnes.erase(lvl_arachnes.begin() + removal_id);
-		return true;
-	}
-
-	//Test monsters
-	cpt = 0;
-	for(auto &lvl_monster : lvl_monsters)
-	{
-		if(SDL_HasIntersection(&mouse_rect, lvl_monster.get_rect()))
-		{
-			removal_id = cpt;			
-		}
-		cpt++;
-	}
-
-	if(removal_id > -1)
-	{
-		lvl_monsters.erase(lvl_monsters.begin() + removal_id);
-		return true;
-	}
-
-	//Test timers (mouahhaha)
-	cpt = 0;
-	for(auto &lvl_tbonus : lvl_tbonuses)
-	{
-		if(SDL_HasIntersection(&mouse_rect, lvl_tbonus.get_rect()))
-		{
-			removal_id = cpt;			
-		}
-		cpt++;
-	}
-
-	if(removal_id > -1)
-	{
-		lvl_tbonuses.erase(lvl_tbonuses.begin() + removal_id);
-		return true;
+		return false;
 	}
 
-
-	return false;
+	remove_entity(*lChunk, lIdx);
+	return true;
 }
 
 /**
@@ -868,27 +1041,45 @@ bool Level::erase_under(int pMouseX, int pMouseY)
  **/
 void Level::on_event(SDL_Event* pEvent)
 {
+	//Moves out of the map are cancelled
+	Position lPos;
+
 	switch(pEvent->type)
 	{
 		case SDL_KEYDOWN:
 			switch(pEvent->key.keysym.sym)
 			{
 				case SDLK_LEFT:
+					lPos = lvl_player.get_pos();
 					lvl_player.move_x(-1);
+					if(!check_map_bounds())
+					{
+						lvl_player.set_pos(lPos);
+					}
 					if(check_ground_collision() == true)
 					{
 						lvl_player.move_x(1);
 					}
 					break;
 				case SDLK_RIGHT:
+					lPos = lvl_player.get_pos();
 					lvl_player.move_x(1);
+					if(!check_map_bounds())
+					{
+						lvl_player.set_pos(lPos);
+					}
 					if(check_ground_collision() == true)
 					{
 						lvl_player.move_x(-1);
 					}
 					break;
 				case SDLK_UP:
+					lPos = lvl_player.get_pos();
 					lvl_player.move_y(-2);
+					if(!check_map_bounds())
+					{
+						lvl_player.set_pos(lPos);
+					}
 					if(check_ground_collision() == true)
 					{
 						lvl_player.move_y(1);
@@ -901,11 +1092,16 @@ void Level::on_event(SDL_Event* pEvent)
 			}
 			break;
 		case SDL_MOUSEBUTTONDOWN:
-			if(erase_under(pEvent->motion.x, pEvent->motion.y))
+			//Screen to map coordinates
+			if(erase_under(pEvent->motion.x + lvl_camera.get_view().x, pEvent->motion.y + lvl_camera.get_view().y))
 			{
 				//Play sound only if something erasable is under the eraser
-				Mix_PlayChannel(-1, sfx_eraser, 0); 
+				lvl_audio->play_sound(lvl_assets->sfx_eraser);
 			}
 			break;
+		case SDL_RENDER_TARGETS_RESET:
+			//The static layer content is lost
+			is_static_dirty = true;
+			break;
 	}
 }	
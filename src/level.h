@@ -3,90 +3,157 @@
 
 #include <SDL2/SDL.h>
 
-#ifdef __APPLE__
-#include <SDL2_image/SDL_image.h>
-#include <SDL2_mixer/SDL_mixer.h>
-#include <SDL2_ttf/SDL_ttf.h>
-#else
-#include <SDL2/SDL_image.h>
-#include <SDL2/SDL_mixer.h>
-#include <SDL2/SDL_ttf.h>
-#endif
-
-#include <fstream>
 #include <string>
 #include <vector>
+#include <map>
+#include <set>
+#include <unordered_set>
+#include <memory>
 #include <iostream>
 
 #include "position.h"
 #include "player.h"
-#include "door.h"
-#include "pencil.h"
-#include "spike.h"
-#include "plantivorus.h"
-#include "arachne.h"
-#include "ghost.h"
-#include "monster.h"
-#include "time_bonus.h"
+#include "entity_store.h"
+#include "timer_wheel.h"
+#include "spatial_hash.h"
+#include "texture_cache.h"
+#include "level_context.h"
+#include "level_map.h"
+#include "camera.h"
+#include "chunk_file.h"
+#include "chunk_loader.h"
+#include "level_chunk.h"
 
 /**
  * \class Level
- * \brief Game level 
+ * \brief Game level (logic of the eraser_core library: drawing and sounds go
+ *        through the GameRenderer and GameAudio interfaces of the context)
  **/
 class Level
 {
 	private:
 		int available_time{15};
-		int current_time{0};
-		int next_time_refresh{0};
-		int next_fall_down{0};
-		int next_spikes_update{0};
-		int next_plants_update{0};
-		int next_arachnes_update{0};
-		int next_monster_move{0};
 
-		std::string lvl_bg_path;
-		std::string lvl_map_path;
-		std::string lvl_asset_path;
+		//Clock of the last update and time not simulated yet (less than a step after an update)
+		Uint32 last_update{0};
+		bool is_clock_started{false};
+		Uint32 step_lag{0};
+
+		//Fraction of a step since the last step (the sprites are drawn between the last two steps)
+		float step_alpha{1.0f};
+
+		//Periodic rules (one tick per step) and the events due at the current step
+		TimerWheel lvl_timers;
+		std::vector<int> due_events;
+
+		AssetId lvl_bg_id{Vfs::INVALID_ASSET};
+		AssetId lvl_map_id{Vfs::INVALID_ASSET};
+
+		//Game files
+		Vfs* lvl_vfs{nullptr};
+		const LevelAssets* lvl_assets{nullptr};
+
+		//Music and sounds shared by every level
+		GameAudio* lvl_audio{nullptr};
+
+		//Frame renderer
+		GameRenderer* lvl_renderer{nullptr};
+
+		//Shared level textures
+		TextureCache lvl_textures;
+
+		SDL_Texture* bg_texture{nullptr};
+
+		//Background and ground of the view composed once (rebuilt when dirty, when
+		//targets are reset or when the view moved)
+		SDL_Texture* static_texture{nullptr};
+		SDL_Rect static_view = {0, 0, 0, 0};
+		bool is_static_dirty = true;
+
+		//Static layer composed by the render thread from the snapshots (simulation
+		//thread), stamp changed with its view or content
+		bool is_static_remote = false;
+		Uint32 static_stamp{0};
 
-		SDL_Surface* bg_image;
-		SDL_Texture* bg_texture;
+		//Map area (pixels) and view following the player
+		SDL_Rect map_rect = {0, 0, 0, 0};
+		Camera lvl_camera;
 
 		SDL_Color txt_color = {0, 0, 0};
-		TTF_Font* txt_font;
-		SDL_Texture* timer_texture;
-		SDL_Rect timer_rect;
+		char timer_text[16] = "";
 		SDL_Rect timer_pos_rect;
 
-		SDL_Surface* ground_image;	
-		SDL_Texture* ground_texture;
+		SpriteSheet ground_sheet;
 		SDL_Rect sprite_rect;
 		SDL_Rect bg_rect;
 
-		std::vector<SDL_Rect> lvl_ground;
+		//Shared sheet of every entity kind
+		SpriteSheet entity_sheets[EntityStore::KINDS];
 
 		Player lvl_player;
-		Door lvl_door;
 
-		std::vector<Pencil> lvl_pencils;
-		std::vector<Spike> lvl_spikes;
-		std::vector<Plantivorus> lvl_plants;
-		std::vector<Arachne> lvl_arachnes;
-		std::vector<Ghost> lvl_ghosts;
-		std::vector<Monster> lvl_monsters;
+		//Resident chunks (ground and entities), row by row
+		std::map<Uint64, LevelChunk> lvl_chunks;
 
-		std::vector<TimeBonus> lvl_tbonuses;
+		//Chunked map streamed around the player (nullptr when the map is loaded whole)
+		std::shared_ptr<ChunkLoader> lvl_loader;
+		std::set<Uint64> requested_chunks;
 
-		Mix_Music* lvl_music;
-		Mix_Chunk* sfx_eraser;
-		Mix_Chunk* sfx_die_splash;
-		Mix_Chunk* sfx_get_time;
+		//Spawn tiles of the erased and picked up entities (not spawned again with their chunk)
+		std::unordered_set<Uint64> consumed_spawns;
 
-		//Add rect to lvl_ground vector
-		void add_rect(int pX, int pY);
+		//Entities of the resident chunks by cell (collision and eraser queries), last query result
+		SpatialHash lvl_hash;
+		std::vector<SpatialHash::Entry> found_entities;
+
+		//Initialize the background and ground rects
+		void init_rects();
 
 		//Load the level map
-		bool load_map(std::string pMapFilepath);
+		bool load_map(AssetId pMapId);
+
+		//Open a chunked map and load the chunks around the player
+		bool load_chunked_map(AssetId pChunksId);
+
+		//Key of a chunk or of a tile
+		static Uint64 make_key(int pX, int pY){return ((Uint64)(Uint32)pY << 32) | (Uint32)pX;}
+
+		//Getter for a resident chunk (nullptr if it is not loaded)
+		LevelChunk* find_chunk(int pX, int pY);
+
+		//Spawn the ground and the entities of a chunk
+		void add_chunk(const ChunkData& pData);
+
+		//Register the periodic rules in the timer wheel
+		void schedule_events();
+
+		//Run one fixed simulation step
+		int step();
+
+		//Load the chunks around the player, evict the far ones
+		void stream_chunks();
+
+		//Tile and chunk of a map coordinate (pixels)
+		static int tile_at(int pPixel){return (pPixel >= 0) ? pPixel / LevelMap::TILE_SIZE : (pPixel - LevelMap::TILE_SIZE + 1) / LevelMap::TILE_SIZE;}
+		static int chunk_at(int pPixel){return ChunkFile::chunk_of(tile_at(pPixel));}
+
+		//Check if a tile holds ground (false in the chunks not loaded)
+		bool has_ground(int pTileX, int pTileY);
+
+		//Getter for the sprite sheet asset of an entity kind
+		AssetId get_kind_asset(int pKind);
+
+		//Release the sheet of a removed entity (kept while the map is streamed)
+		void release_texture(AssetId pAsset);
+
+		//Remove an entity of a chunk (not spawned again with the chunk)
+		void remove_entity(LevelChunk& pChunk, size_t pIdx);
+
+		//Find an entity of the masked kinds intersecting a rect
+		LevelChunk* find_entity(const SDL_Rect& pRect, Uint32 pKindMask, size_t* pIdx);
+
+		//Indicator if level is prepared (map parsed, images decoded)
+		bool is_prepare = false;
 
 		//Indicator if level is loaded
 		bool is_load = false;
@@ -94,33 +161,68 @@ class Level
 		//Indicator if level is finished
 		bool is_finish = false;
 
+		//Performance counter when the player reached the door
+		Uint64 finish_counter{0};
+
 	public:
 		//Bonus of 5 sec
 		static const int TIME_BONUS_VALUE = 5; 
 
+		//Fixed simulation step (ms), steps run at most by an update (the rest of a longer hitch is dropped)
+		static const int STEP_TIME = 10;
+		static const int MAX_CATCH_UP_STEPS = 10;
+
+		//Periods of the countdown and of the gravity (ms)
+		static const int COUNTDOWN_PERIOD = 1000;
+		static const int FALL_PERIOD = 80;
+
+		//Timer wheel events (entity steps: one per kind and phase)
+		static const int EVENT_COUNTDOWN = 0;
+		static const int EVENT_FALL = 1;
+		static const int EVENT_ENTITY_STEP = 2;
+
+		//Streamed chunks around the chunk of the player: read now, read in the background, evicted beyond
+		static const int REQUIRED_RADIUS = 1;
+		static const int PREFETCH_RADIUS = 2;
+		static const int EVICT_RADIUS = 3;
+
+		//Level states (update result)
+		static const int PLAYING = 0;
+		static const int FINISHED = 1;
+		static const int FAILED = 2;
+		static const int TIME_OUT = 3;
+
 		//Constructor
 		Level(){};
 
-		Level(std::string pMapPath, std::string pBgPath, std::string pAssetPath)
+		Level(AssetId pMapId, AssetId pBgId, const LevelContext* pContext)
 		{
-			lvl_map_path = pMapPath;
-			lvl_asset_path = pAssetPath;
+			lvl_map_id = pMapId;
+			lvl_assets = pContext->assets;
+			lvl_vfs = pContext->vfs;
+			lvl_audio = pContext->audio;
+			lvl_renderer = pContext->renderer;
+			lvl_textures = TextureCache(pContext->vfs, pContext->pool);
 			
-			std::ifstream bg_file(pBgPath);		
-			if(bg_file.is_open())
+			if(lvl_vfs->exists(pBgId))
 			{
-				lvl_bg_path = pBgPath;
-				bg_file.close();
+				lvl_bg_id = pBgId;
 			}
 			else
 			{
-				lvl_bg_path = pAssetPath + "bg.png";
+				lvl_bg_id = lvl_assets->bg;
 			}
 		}
 
-		//Load the level
+		//Parse the map and decode the images (no renderer, can run on a worker thread)
+		bool prepare();
+
+		//Load the level (prepared first if needed)
 		bool load(SDL_Renderer* pRenderer);
 
+		//Load the map only (no image nor texture, for headless simulations)
+		bool load_headless();
+
 		//Unload the level (cleanup memory)
 		void unload();
 
@@ -133,17 +235,50 @@ class Level
 		//Getter for is_loaded indicator
 		bool is_loaded(){return is_load;}
 
+		//Getter for is_prepared indicator
+		bool is_prepared(){return is_prepare;}
+
+		//Getter for the performance counter when the level was finished
+		Uint64 get_finish_counter(){return finish_counter;}
+
+		//Send the render commands to another renderer (a simulation snapshot)
+		void set_renderer(GameRenderer* pRenderer){lvl_renderer = pRenderer;}
+
+		//Keep the released textures until unload (commands recorded earlier may still be drawn)
+		void set_deferred_release(bool pIsDeferred){lvl_textures.set_deferred(pIsDeferred);}
+
+		//Let the render thread compose the static layer (render sends no background nor ground)
+		void set_static_remote(bool pIsRemote){is_static_remote = pIsRemote;}
+
+		//Getter for the stamp of the static layer (changed with its view or content)
+		Uint32 get_static_stamp(){return static_stamp;}
+
 		//Initialize the texture to be rendered
 		bool init_textures(SDL_Renderer* pRenderer);
 
+		//Compose the background and the ground into the static layer
+		bool build_static_layer(SDL_Renderer* pRenderer);
+
+		//Compose the static layer if it is dirty
+		void update_static_layer(SDL_Renderer* pRenderer);
+
+		//Draw the static layer (background and ground)
+		void render_static_layer(SDL_Renderer* pRenderer);
+
+		//Send the background tiles and the ground in the view
+		void render_tiles();
+
 		//Launch the music
 		void play_bg_music();
 
 		//Check for collision with a given SDL_Rect
 		bool check_ground_collision();
 
-		//Check for collision with timer bonuses
-		int check_time_bonus_collision();
+		//Check if the player is inside the map
+		bool check_map_bounds();
+
+		//Pick up the time bonus under the player
+		bool take_time_bonus();
 
 		//Check collisions with dangerous things
 		bool check_danger_collision();
@@ -151,17 +286,14 @@ class Level
 		//Check for collision between player_rect and door
 		bool check_door_collision();
 
-		//Refresh timer
-		void refresh_timer(SDL_Renderer* pRenderer);
-
-		//Display no more time picture
-		void display_no_more_time(SDL_Renderer* pRenderer);
+		//Refresh timer text
+		void refresh_timer();
 
-		//Display failure message
-		void display_fail(SDL_Renderer* pRenderer);
+		//Move the level to the given game time (ms)
+		int update(Uint32 pTime);
 
-		//Render the texture through given renderer
-		bool render(SDL_Renderer* pRenderer);
+		//Send the render commands of the level
+		void render(SDL_Renderer* pRenderer);
 
 		//Erase everything under the eraser
 		bool erase_under(int pMouseX, int pMouseY);
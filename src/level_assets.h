@@ -0,0 +1,72 @@
+#ifndef LEVEL_ASSETS_H
+#define LEVEL_ASSETS_H
+
+#include <string>
+#include "vfs.h"
+
+/**
+ * \struct LevelAssets
+ * \brief IDs of the game files shared by every level (interned once)
+ **/
+struct LevelAssets
+{
+	std::string path;
+
+	AssetId font;
+	AssetId music;
+	AssetId sfx_eraser;
+	AssetId sfx_die_splash;
+	AssetId sfx_get_time;
+
+	AssetId pic_notime;
+	AssetId pic_fail;
+	AssetId pic_end;
+
+	AssetId bg;
+	AssetId ground;
+	AssetId player;
+	AssetId door;
+	AssetId pencil;
+	AssetId spike;
+	AssetId plant;
+	AssetId arachne;
+	AssetId ghost;
+	AssetId monster;
+	AssetId timebonus;
+
+	AssetId atlas_index;
+	AssetId atlas_image;
+
+	//Intern the files of the given assets directory
+	void init(Vfs* pVfs, std::string pAssetPath)
+	{
+		path = pAssetPath;
+
+		font = pVfs->intern(pAssetPath + "ThinPencilHandwriting.ttf");
+		music = pVfs->intern(pAssetPath + "sfx/music.ogg");
+		sfx_eraser = pVfs->intern(pAssetPath + "sfx/eraser.wav");
+		sfx_die_splash = pVfs->intern(pAssetPath + "sfx/dead_splash.wav");
+		sfx_get_time = pVfs->intern(pAssetPath + "sfx/timer.wav");
+
+		pic_notime = pVfs->intern(pAssetPath + "pic_notime.png");
+		pic_fail = pVfs->intern(pAssetPath + "pic_fail.png");
+		pic_end = pVfs->intern(pAssetPath + "pic_end.png");
+
+		bg = pVfs->intern(pAssetPath + "bg.png");
+		ground = pVfs->intern(pAssetPath + "ground.png");
+		player = pVfs->intern(pAssetPath + "playersheet.png");
+		door = pVfs->intern(pAssetPath + "hole.png");
+		pencil = pVfs->intern(pAssetPath + "pencil.png");
+		spike = pVfs->intern(pAssetPath + "spike.png");
+		plant = pVfs->intern(pAssetPath + "plant.png");
+		arachne = pVfs->intern(pAssetPath + "arachne.png");
+		ghost = pVfs->intern(pAssetPath + "ghost.png");
+		monster = pVfs->intern(pAssetPath + "monster.png");
+		timebonus = pVfs->intern(pAssetPath + "timer.png");
+
+		atlas_index = pVfs->intern(pAssetPath + "atlas.idx");
+		atlas_image = pVfs->intern(pAssetPath + "atlas.png");
+	}
+};
+
+#endif
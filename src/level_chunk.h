@@ -0,0 +1,29 @@
+#ifndef LEVEL_CHUNK_H
+#define LEVEL_CHUNK_H
+
+#include <vector>
+#include <SDL2/SDL.h>
+#include "entity_store.h"
+#include "chunk_file.h"
+
+/**
+ * \struct LevelChunk
+ * \brief Resident chunk of a level: its ground and the entities spawned
+ *        from it (a monster stays in the chunk of its range start)
+ **/
+struct LevelChunk
+{
+	static_assert(ChunkFile::CHUNK_TILES <= 16, "A chunk row of ground tiles must fit in 16 bits");
+
+	//Chunk coordinates (chunks)
+	int x{0};
+	int y{0};
+
+	//Ground rects (drawn) and ground tiles, one bit per tile of a row (collisions)
+	std::vector<SDL_Rect> ground;
+	Uint16 ground_rows[ChunkFile::CHUNK_TILES];
+
+	EntityStore entities;
+};
+
+#endif
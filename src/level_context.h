@@ -0,0 +1,33 @@
+#ifndef LEVEL_CONTEXT_H
+#define LEVEL_CONTEXT_H
+
+#include "level_assets.h"
+#include "vfs.h"
+#include "decode_pool.h"
+#include "game_audio.h"
+#include "game_renderer.h"
+
+/**
+ * \struct LevelContext
+ * \brief Game services shared by every level (owned by LevelManager,
+ *        or by the headless simulation with the null renderer and audio)
+ **/
+struct LevelContext
+{
+	//Interned game files
+	const LevelAssets* assets{nullptr};
+
+	//Game files
+	Vfs* vfs{nullptr};
+
+	//Image decode pool
+	DecodePool* pool{nullptr};
+
+	//Music and sounds
+	GameAudio* audio{nullptr};
+
+	//Frame renderer (render commands and texts)
+	GameRenderer* renderer{nullptr};
+};
+
+#endif
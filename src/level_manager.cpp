@@ -1,51 +1,78 @@
 #include "level_manager.h"
-#include <fstream>
-
-#ifdef __APPLE__
-#include <SDL2_ttf/SDL_ttf.h>
-#else
-#include <SDL2/SDL_ttf.h>
-#endif
+#include <sstream>
 
 /**
  * init_paths
- * \param pPath : Game paths 
- * \brief Init paths 
+ * \brief Init paths (relative to the game base path)
  * \return void
  * */
-void LevelManager::init_paths(std::string pPath)
+void LevelManager::init_paths()
 {
-	level_base_path = pPath;
-	level_data_path = level_base_path + "data/";
-	level_asset_path = level_base_path + "assets/";
+	level_data_path = "data/";
+	level_asset_path = "assets/";
 	index_path = level_data_path + INDEX_FILENAME;
 }
 
 /**
  * load_index
  * \param pRenderer : Game renderer 
- * \param pPath : Game base path
+ * \param pVfs : Game files
+ * \param pPool : Image decode pool
+ * \param pQueue : Frame render queue
  * \brief Load the lvl_index file
  * \return boolean : load index status
  **/
-bool LevelManager::load_index(SDL_Renderer* pRenderer, std::string pPath)
+bool LevelManager::load_index(SDL_Renderer* pRenderer, Vfs* pVfs, DecodePool* pPool, RenderQueue* pQueue)
 {
-	init_paths(pPath);
-	std::ifstream index_file(index_path);
-	if(index_file.is_open())
+	vfs = pVfs;
+	pool = pPool;
+	queue = pQueue;
+	init_paths();
+	level_assets.init(vfs, level_asset_path);
+
+	//Load the music and the sounds once for every level
+	audio = AudioBank(vfs);
+	if(!audio.load_music(level_assets.music) ||
+		!audio.load_chunk(level_assets.sfx_eraser, 60) ||
+		!audio.load_chunk(level_assets.sfx_die_splash, 20) ||
+		!audio.load_chunk(level_assets.sfx_get_time, 20))
+	{
+		return false;
+	}
+
+	//Rasterize the font once
+	if(!text.load(pRenderer, vfs, level_assets.font, 40))
+	{
+		return false;
+	}
+
+	level_context.assets = &level_assets;
+	level_context.vfs = vfs;
+	level_context.pool = pool;
+	level_context.audio = &audio;
+	level_context.renderer = queue;
+	queue->set_text(&text);
+
+	std::string index_content;
+	if(vfs->read(vfs->intern(index_path), index_content))
 	{
+		std::istringstream index_file(index_content);
 		std::string line;
 		while(getline(index_file, line))
 		{
 			level_ids.push_back(line);
+			level_map_ids.push_back(vfs->intern(level_data_path + line + "/" + LEVEL_MAP_FILENAME));
+			level_bg_ids.push_back(vfs->intern(level_data_path + line + "/" + LEVEL_BG_FILENAME));
 		}	
-		index_file.close();	
 	}
 	else
 	{
 		return false;
 	}
 
+	//The first level is prepared while the menu is displayed
+	start_prefetch(0);
+
 	return true;	
 }
 
@@ -59,11 +86,13 @@ bool LevelManager::display(SDL_Renderer* pRenderer)
 {
 	if(current_level_id > -1)
 	{
-		if(current_level.is_finished())
+		//Finished at the previous frame (the simulation is stopped then)
+		if(current_state == Level::FINISHED)
 		{
 			//Load next level
 			if(!prepare_next_level(pRenderer))
 			{
+				audio.stop_music();
 				current_level_id = -1;
 				return false;
 			}
@@ -74,6 +103,7 @@ bool LevelManager::display(SDL_Renderer* pRenderer)
 		//Load the first level
 		if(!prepare_next_level(pRenderer))
 		{
+			audio.stop_music();
 			current_level_id = -1;
 			return false;
 		}
@@ -81,15 +111,71 @@ bool LevelManager::display(SDL_Renderer* pRenderer)
 
 	if(start_time == -1)
 	{
-		start_time = SDL_GetTicks();
+		start_time = get_game_time();
+	}
+
+	//Latest tick of the simulation thread (its last one if it stopped by itself), or update the level now
+	const FrameSnapshot* lSnapshot = nullptr;
+	int lState;
+	if(is_threaded)
+	{
+		lSnapshot = &sim.get_snapshot();
+		lState = lSnapshot->state;
+	}
+	else if(is_paused)
+	{
+		lState = Level::PLAYING;
 	}
+	else
+	{
+		lState = current_level.update(get_game_time());
+	}
+
+	current_state = lState;
 
-	if(!current_level.render(pRenderer))
+	//Level over: the simulation has stopped (or stops now), the level is ours again
+	if(lState != Level::PLAYING)
 	{
+		sim.stop();
+	}
+
+	if(lState == Level::FAILED || lState == Level::TIME_OUT)
+	{
+		if(lState == Level::FAILED)
+		{
+			SDL_Delay(200);
+			display_picture(pRenderer, level_assets.pic_fail);
+		}
+		else
+		{
+			display_picture(pRenderer, level_assets.pic_notime);
+		}
+
 		current_level.unload();
 		current_level_id = -1;
+		audio.stop_music();
+
+		//Prepare the first sheet again for the next game
+		start_prefetch(0);
 		return false;
 	}
+	if(lSnapshot != nullptr)
+	{
+		render_static_layer(pRenderer, *lSnapshot);
+		lSnapshot->replay(queue);
+	}
+	else
+	{
+		current_level.render(pRenderer);
+	}
+
+	//First frame of the next sheet
+	if(transition_counter != 0)
+	{
+		double lElapsed = (double)(SDL_GetPerformanceCounter() - transition_counter) * 1000.0 / SDL_GetPerformanceFrequency();
+		std::cout << "Level transition: " << lElapsed << " ms" << std::endl;
+		transition_counter = 0;
+	}
 
 	return true;
 }
@@ -97,13 +183,19 @@ bool LevelManager::display(SDL_Renderer* pRenderer)
 /**
  * prepare_next_level
  * \param pRenderer : Game renderer
- * \brief Start the next level and return it
+ * \brief Start the next level and return it (the simulation thread is joined
+ *        before the current level is unloaded and replaced)
  * \return boolean : prepare next level status
  **/
 bool LevelManager::prepare_next_level(SDL_Renderer* pRenderer)
 {
+	sim.stop();
+	current_state = Level::PLAYING;
+
 	if(current_level_id > -1)
 	{
+		transition_counter = current_level.get_finish_counter();
+
 		std::cout << "Unloading previous level" << std::endl;
 		current_level.unload();
 	}
@@ -111,65 +203,234 @@ bool LevelManager::prepare_next_level(SDL_Renderer* pRenderer)
 	current_level_id++;
 	if(current_level_id == (int)level_ids.size())
 	{
+		transition_counter = 0;
 		display_happy_ending(pRenderer);
 		return false;
 	}
-	std::string lvl_map = level_data_path + level_ids[current_level_id] + "/" + LEVEL_MAP_FILENAME;
-	std::string lvl_bg_path = level_data_path + level_ids[current_level_id] + "/" + LEVEL_BG_FILENAME;
-	current_level = Level(lvl_map, lvl_bg_path, level_asset_path);
+
+	//Take the prefetched level (only the texture upload is left)
+	wait_prefetch();
+	if(next_level_id == current_level_id)
+	{
+		if(!next_level_status)
+		{
+			discard_prefetch();
+			return false;
+		}
+		current_level = next_level;
+		next_level = Level();
+		next_level_id = -1;
+	}
+	else
+	{
+		discard_prefetch();
+		current_level = Level(level_map_ids[current_level_id], level_bg_ids[current_level_id], &level_context);
+	}
 
 	if(!current_level.load(pRenderer))
 	{
 		return false;
 	}
 
+	//New textures (maybe at the addresses of the previous ones): redraw the whole frame
+	queue->invalidate();
+
+	//Simulate the level on its thread (the static layer is composed here, from its snapshots)
+	if(is_threaded)
+	{
+		sim.start(&current_level);
+	}
+
+	//Prepare the next sheet while this one is played
+	start_prefetch(current_level_id + 1);
+
 	return true;
 }
 
 /**
- * display_stats
+ * build_static_layer
  * \param pRenderer : Game renderer
- * \param pElapsedTime : Game chrono (can be used to awards player)
- * \brief Display ending stats
+ * \param pSnapshot : Latest simulation snapshot
+ * \brief Compose the background and the ground of the snapshot view into a target texture
+ * \return boolean : build status (false if render targets are not supported)
+ **/
+bool LevelManager::build_static_layer(SDL_Renderer* pRenderer, const FrameSnapshot& pSnapshot)
+{
+	if(!SDL_RenderTargetSupported(pRenderer))
+	{
+		return false;
+	}
+
+	if(static_texture == nullptr)
+	{
+		static_texture = SDL_CreateTexture(pRenderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, Camera::VIEW_WIDTH, Camera::VIEW_HEIGHT);
+		if(static_texture == nullptr)
+		{
+			std::cerr << "Cannot create the static layer: " << SDL_GetError() << std::endl;
+			return false;
+		}
+
+		//Opaque layer : copied without blending
+		SDL_SetTextureBlendMode(static_texture, SDL_BLENDMODE_NONE);
+	}
+
+	SDL_Texture* lTarget = SDL_GetRenderTarget(pRenderer);
+	if(SDL_SetRenderTarget(pRenderer, static_texture) < 0)
+	{
+		return false;
+	}
+
+	SDL_RenderClear(pRenderer);
+	pSnapshot.draw_static(pRenderer);
+	SDL_SetRenderTarget(pRenderer, lTarget);
+
+	return true;
+}
+
+/**
+ * render_static_layer
+ * \param pRenderer : Game renderer
+ * \param pSnapshot : Latest simulation snapshot
+ * \brief Add the static layer of a snapshot to the render queue: one copy of
+ *        the texture composed again when its stamp changed, or every tile when
+ *        render targets are not supported
  * \return void
  **/
-void LevelManager::display_stats(SDL_Renderer* pRenderer, int pElapsedTime)
+void LevelManager::render_static_layer(SDL_Renderer* pRenderer, const FrameSnapshot& pSnapshot)
 {
-	TTF_Font* txt_font = TTF_OpenFont((level_asset_path + "ThinPencilHandwriting.ttf").c_str(), 40);
-	if(!txt_font)
+	if(!is_static_valid || static_stamp != pSnapshot.get_static_stamp())
 	{
-		std::cerr << "Cannot load the font" << std::endl;
+		is_static_valid = build_static_layer(pRenderer, pSnapshot);
+		static_stamp = pSnapshot.get_static_stamp();
+
+		//Same command, new content (the damaged areas only come from the commands)
+		queue->invalidate();
+	}
+
+	if(is_static_valid)
+	{
+		SDL_Rect lRect = {0, 0, Camera::VIEW_WIDTH, Camera::VIEW_HEIGHT};
+		queue->push(GameRenderer::LAYER_BACKGROUND, static_texture, lRect, lRect);
 	}
 	else
 	{
-		SDL_Color txt_color = {0, 0, 0};
-		std::string text = "Congratulations !\n\nYou have used " + 
-			std::to_string(level_ids.size()) + " sheets in " + 
-			std::to_string(pElapsedTime) + " seconds."; 
-	
-		SDL_Surface* txt_image = TTF_RenderText_Blended_Wrapped(txt_font, text.c_str(), txt_color, 400);
-		SDL_Texture* txt_texture = SDL_CreateTextureFromSurface(pRenderer, txt_image);
-		SDL_FreeSurface(txt_image);
+		pSnapshot.replay_static(queue);
+	}
+}
 
-		int lWidth{0};
-		int lHeight{0};
-		SDL_QueryTexture(txt_texture, nullptr, nullptr, &lWidth, &lHeight);
-		
-		SDL_Rect text_rect;		
-		text_rect.w = lWidth;
-		text_rect.h = lHeight;
-		text_rect.x = 0;
-		text_rect.y = 0;
+/**
+ * start_prefetch
+ * \param pLevelId : Level to prepare
+ * \brief Parse the map and decode the images of a level on the worker thread
+ * \return void
+ **/
+void LevelManager::start_prefetch(int pLevelId)
+{
+	discard_prefetch();
+	if(pLevelId >= (int)level_ids.size())
+	{
+		return;
+	}
 
-		SDL_Rect text_pos_rect;
-		text_pos_rect.w = lWidth;
-		text_pos_rect.h = lHeight;
-		text_pos_rect.x = 30;
-		text_pos_rect.y = 250;
+	next_level_id = pLevelId;
+	next_level_status = false;
+	next_level = Level(level_map_ids[pLevelId], level_bg_ids[pLevelId], &level_context);
+	prefetch_thread = std::thread([this]()
+	{
+		next_level_status = next_level.prepare();
+	});
+}
 
-		SDL_RenderCopy(pRenderer, txt_texture, &text_rect, &text_pos_rect);
+/**
+ * wait_prefetch
+ * \brief Wait for the worker thread to finish the prefetched level
+ * \return void
+ **/
+void LevelManager::wait_prefetch()
+{
+	if(prefetch_thread.joinable())
+	{
+		prefetch_thread.join();
+	}
+}
+
+/**
+ * discard_prefetch
+ * \brief Free the prefetched level (when it is not the next one played)
+ * \return void
+ **/
+void LevelManager::discard_prefetch()
+{
+	wait_prefetch();
+	if(next_level_id > -1)
+	{
+		next_level.unload();
+		next_level = Level();
+		next_level_id = -1;
+	}
+}
 
-		TTF_CloseFont(txt_font);
+/**
+ * dispose
+ * \brief Stop the simulation, free the prefetched level, the static layer, the audio bank and the glyph atlas
+ * \return void
+ **/
+void LevelManager::dispose()
+{
+	sim.stop();
+	discard_prefetch();
+	if(static_texture != nullptr)
+	{
+		SDL_DestroyTexture(static_texture);
+		static_texture = nullptr;
+	}
+	is_static_valid = false;
+	audio.clear();
+	text.dispose();
+}
+
+/**
+ * display_stats
+ * \param pRenderer : Game renderer
+ * \param pElapsedTime : Game chrono (can be used to awards player)
+ * \brief Display ending stats
+ * \return void
+ **/
+void LevelManager::display_stats(SDL_Renderer* pRenderer, int pElapsedTime)
+{
+	SDL_Color txt_color = {0, 0, 0};
+	std::string stats_text = "Congratulations !\n\nYou have used " + 
+		std::to_string(level_ids.size()) + " sheets in " + 
+		std::to_string(pElapsedTime) + " seconds."; 
+
+	queue->draw_text(stats_text.c_str(), 30, 250, txt_color, 400);
+	queue->submit(pRenderer);
+}
+
+/**
+ * display_picture
+ * \param pRenderer : Game renderer
+ * \param pId : Picture (failure, time's up)
+ * \brief Display a full screen picture for 2 seconds
+ * \return void
+ **/
+void LevelManager::display_picture(SDL_Renderer* pRenderer, AssetId pId)
+{
+	//Drawn at once, without the commands of the current frame
+	queue->clear();
+	SDL_RenderClear(pRenderer);	
+
+	SDL_Surface* image = IMG_Load_RW(vfs->open(pId), 1);
+	SDL_Texture* texture = SDL_CreateTextureFromSurface(pRenderer, image);
+	SDL_FreeSurface(image);
+	if(texture != nullptr)
+	{
+		SDL_RenderCopy(pRenderer, texture, nullptr, nullptr);
+		SDL_RenderPresent(pRenderer);
+		SDL_DestroyTexture(texture);
+		
+		//Slow down cycles
+		SDL_Delay(2000);
 	}
 }
 
@@ -182,11 +443,13 @@ void LevelManager::display_stats(SDL_Renderer* pRenderer, int pElapsedTime)
 void LevelManager::display_happy_ending(SDL_Renderer* pRenderer)
 {
 	//Elapsed time since the first level (s)
-	int elapsed_time = (SDL_GetTicks() - start_time)/1000; 
+	int elapsed_time = (get_game_time() - start_time)/1000; 
 	
+	//Drawn at once, without the commands of the current frame
+	queue->clear();
 	SDL_RenderClear(pRenderer);	
 	
-	SDL_Surface* end_image = IMG_Load((level_asset_path + "pic_end.png").c_str());
+	SDL_Surface* end_image = IMG_Load_RW(vfs->open(level_assets.pic_end), 1);
 	SDL_Texture* end_texture = SDL_CreateTextureFromSurface(pRenderer, end_image);
 	if(end_texture > 0)
 	{
@@ -201,6 +464,32 @@ void LevelManager::display_happy_ending(SDL_Renderer* pRenderer)
 	}
 }
 
+/**
+ * set_paused
+ * \param pIsPaused : Window in the background
+ * \brief Stop or restart the level clock: the simulation thread waits without
+ *        ticking, the time spent paused is not caught up on resume
+ * \return void
+ **/
+void LevelManager::set_paused(bool pIsPaused)
+{
+	if(pIsPaused == is_paused)
+	{
+		return;
+	}
+
+	is_paused = pIsPaused;
+	sim.set_paused(pIsPaused);
+	if(is_paused)
+	{
+		pause_start = SDL_GetTicks();
+	}
+	else
+	{
+		paused_time += SDL_GetTicks() - pause_start;
+	}
+}
+
 /**
  * on_event
  * \param pEvent : Event
@@ -209,7 +498,18 @@ void LevelManager::display_happy_ending(SDL_Renderer* pRenderer)
  **/
 void LevelManager::on_event(SDL_Event* pEvent)
 {
-	if(current_level_id > -1)
+	//The static layer content is lost
+	if(pEvent->type == SDL_RENDER_TARGETS_RESET)
+	{
+		is_static_valid = false;
+	}
+
+	if(sim.is_running())
+	{
+		//Full input queue: the event is dropped
+		sim.post_event(*pEvent);
+	}
+	else if(current_level_id > -1)
 	{
 		current_level.on_event(pEvent);
 	}
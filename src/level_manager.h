@@ -2,9 +2,15 @@
 #define LEVEL_MANAGER_H
 
 #include "level.h"
+#include "level_context.h"
+#include "audio_bank.h"
+#include "text_renderer.h"
+#include "render_queue.h"
+#include "sim_thread.h"
 #include <string>
 #include <iostream>
 #include <vector>
+#include <thread>
 #include <SDL2/SDL.h>
 
 /**
@@ -18,31 +24,105 @@ class LevelManager
 		const std::string LEVEL_MAP_FILENAME = "lvl_map";
 		const std::string LEVEL_BG_FILENAME = "bg.png";
 	
-		std::string level_base_path;
 		std::string level_data_path;
 		std::string level_asset_path;
 		std::string index_path;
 
+		Vfs* vfs{nullptr};
+		DecodePool* pool{nullptr};
+		RenderQueue* queue{nullptr};
+		LevelAssets level_assets;
+
+		//Music and sounds (loaded once, the music streams across levels)
+		AudioBank audio;
+
+		//Glyph atlas of the game font
+		TextRenderer text;
+
+		//Services given to every level
+		LevelContext level_context;
+
 		std::vector<std::string> level_ids;
+		std::vector<AssetId> level_map_ids;
+		std::vector<AssetId> level_bg_ids;
 		Level current_level;
 	
 		int current_level_id{-1};
+
+		//State of the current level at the last frame (from the published snapshot with the simulation thread)
+		int current_state{Level::PLAYING};
 		int start_time{-1};
 
+		//Next level prepared on the worker thread
+		Level next_level;
+		int next_level_id{-1};
+		bool next_level_status{false};
+		std::thread prefetch_thread;
+
+		//Current level simulated on its own thread (ERASER_SIM_THREAD=0 to update it while rendering)
+		SimThread sim;
+		bool is_threaded{true};
+
+		//Window in the background: the level clock is stopped
+		bool is_paused{false};
+
+		//Start of the pause and time spent paused, taken off the game time (ms)
+		Uint32 pause_start{0};
+		Uint32 paused_time{0};
+
+		//Static layer composed from the snapshots (simulation thread), stamp and content status
+		SDL_Texture* static_texture{nullptr};
+		Uint32 static_stamp{0};
+		bool is_static_valid{false};
+
+		//Performance counter when the previous level was finished (0 if no transition)
+		Uint64 transition_counter{0};
+
 		//initialize paths
-		void init_paths(std::string pPath);
+		void init_paths();
 
 		//Return the next level
 		bool prepare_next_level(SDL_Renderer* pRenderer);
 
+		//Game time (ms, without the pauses)
+		Uint32 get_game_time(){return SDL_GetTicks() - paused_time;}
+
+		//Compose the static layer of a snapshot
+		bool build_static_layer(SDL_Renderer* pRenderer, const FrameSnapshot& pSnapshot);
+
+		//Add the static layer of a snapshot to the frame
+		void render_static_layer(SDL_Renderer* pRenderer, const FrameSnapshot& pSnapshot);
+
+		//Prepare the given level on the worker thread
+		void start_prefetch(int pLevelId);
+
+		//Wait for the worker thread
+		void wait_prefetch();
+
+		//Drop the prefetched level
+		void discard_prefetch();
+
 	public:
 		//Constructor
 		LevelManager()
 		{
 		}
 
+		//Destructor
+		~LevelManager()
+		{
+			sim.stop();
+			wait_prefetch();
+		}
+
+		//Setter for the simulation thread (before the first level)
+		void set_threaded(bool pIsThreaded){is_threaded = pIsThreaded;}
+
+		//Pause or resume the level clock
+		void set_paused(bool pIsPaused);
+
 		//Load the lvl_index file
-		bool load_index(SDL_Renderer* pRenderer, std::string pPath);
+		bool load_index(SDL_Renderer* pRenderer, Vfs* pVfs, DecodePool* pPool, RenderQueue* pQueue);
 
 		//Display the current level
 		bool display(SDL_Renderer* pRenderer);
@@ -50,11 +130,17 @@ class LevelManager
 		//Display ending stats
 		void display_stats(SDL_Renderer* pRenderer, int pElapsedTime);
 
+		//Display a full screen picture (failure, time's up)
+		void display_picture(SDL_Renderer* pRenderer, AssetId pId);
+
 		//Display an happy ending message
 		void display_happy_ending(SDL_Renderer* pRenderer);
 
 		//Event dispatcher
 		void on_event(SDL_Event* pEvent);	
+
+		//Stop the simulation, dispose the prefetched level, the static layer, the audio bank and the glyph atlas
+		void dispose();
 };
 
 #endif
@@ -0,0 +1,322 @@
+#include "level_map.h"
+#include <cstring>
+#include <sstream>
+
+/**
+ * read_u32
+ * \param pData : Compiled map bytes
+ * \brief Read a little-endian 32 bits value
+ * \return Uint32 : value
+ **/
+static Uint32 read_u32(const Uint8* pData)
+{
+	return (Uint32)pData[0] | ((Uint32)pData[1] << 8) | ((Uint32)pData[2] << 16) | ((Uint32)pData[3] << 24);
+}
+
+/**
+ * write_u32
+ * \param pContent : Compiled map
+ * \param pValue : Value
+ * \brief Write a little-endian 32 bits value
+ * \return void
+ **/
+static void write_u32(std::string& pContent, Uint32 pValue)
+{
+	char lBytes[4] = {(char)(pValue & 0xFF), (char)((pValue >> 8) & 0xFF), (char)((pValue >> 16) & 0xFF), (char)((pValue >> 24) & 0xFF)};
+	pContent.append(lBytes, 4);
+}
+
+/**
+ * location
+ * \param pLine : Line index
+ * \param pCol : Column index
+ * \brief Diagnostic prefix of a map cell (1-based)
+ * \return std::string : "line:column: "
+ **/
+static std::string location(int pLine, int pCol)
+{
+	return std::to_string(pLine + 1) + ":" + std::to_string(pCol + 1) + ": ";
+}
+
+/**
+ * parse_text
+ * \param pContent : Text map (one character per tile)
+ * \brief Parse a text map and validate it
+ * \return boolean : parse status (false if there is an error)
+ **/
+bool LevelMap::parse_text(const std::string& pContent)
+{
+	ground.clear();
+	entities.clear();
+	errors.clear();
+	warnings.clear();
+
+	std::istringstream lvl_file(pContent);
+	std::string line;
+	int line_idx{0};
+
+	while(getline(lvl_file, line))
+	{
+		int monster_x1{-1};
+
+		for(int col_idx = 0; col_idx < (int)line.size(); col_idx++)
+		{
+			char lChar = line[col_idx];
+			if(lChar == ' ' || lChar == '\r')
+			{
+				continue;
+			}
+
+			if(lChar == '\0' || std::strchr("*PDA[]SFGTC", lChar) == nullptr)
+			{
+				warnings.push_back(location(line_idx, col_idx) + "unknown character ignored");
+				continue;
+			}
+
+			Entity lEntity;
+			lEntity.type = lChar;
+			lEntity.x = col_idx;
+			lEntity.y = line_idx;
+			lEntity.x_end = col_idx;
+
+			switch(lChar)
+			{
+				case '*': //Ground
+					{
+						SDL_Rect lRect;
+						lRect.w = TILE_SIZE;
+						lRect.h = GROUND_HEIGHT;
+						lRect.x = col_idx * TILE_SIZE;
+						lRect.y = line_idx * TILE_SIZE;
+						ground.push_back(lRect);
+					}
+					break;
+				case '[': //Monster start
+					if(monster_x1 != -1)
+					{
+						errors.push_back(location(line_idx, col_idx) + "'[' inside another monster range");
+					}
+					monster_x1 = col_idx;
+					break;
+				case ']': //Monster end
+					if(monster_x1 == -1)
+					{
+						errors.push_back(location(line_idx, col_idx) + "']' without '['");
+					}
+					else
+					{
+						lEntity.type = MONSTER;
+						lEntity.x = monster_x1;
+						entities.push_back(lEntity);
+					}
+					monster_x1 = -1;
+					break;
+				default:
+					entities.push_back(lEntity);
+					break;
+			}
+		}
+
+		if(monster_x1 != -1)
+		{
+			errors.push_back(location(line_idx, monster_x1) + "'[' without ']'");
+		}
+		line_idx++;
+	}
+
+	return validate();
+}
+
+/**
+ * parse_binary
+ * \param pData : Compiled map bytes (e.g. mapped from the asset archive)
+ * \param pSize : Compiled map size
+ * \brief Load a compiled map, the ground rects are copied in one block, then
+ *        validate it as a text map (a stale or edited file is rejected)
+ * \return boolean : load status
+ **/
+bool LevelMap::parse_binary(const Uint8* pData, size_t pSize)
+{
+	ground.clear();
+	entities.clear();
+	errors.clear();
+	warnings.clear();
+
+	if(pSize < HEADER_SIZE || memcmp(pData, "ELVL", 4) != 0 || read_u32(pData + 4) != VERSION)
+	{
+		errors.push_back("Invalid compiled level map");
+		return false;
+	}
+
+	Uint32 lGroundCount = read_u32(pData + 8);
+	Uint32 lEntityCount = read_u32(pData + 12);
+	if(HEADER_SIZE + ((size_t)lGroundCount + lEntityCount) * RECORD_SIZE > pSize)
+	{
+		errors.push_back("Truncated compiled level map");
+		return false;
+	}
+
+	const Uint8* lRecord = pData + HEADER_SIZE;
+	ground.resize(lGroundCount);
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+	if(lGroundCount > 0)
+	{
+		memcpy(ground.data(), lRecord, (size_t)lGroundCount * RECORD_SIZE);
+	}
+	lRecord += (size_t)lGroundCount * RECORD_SIZE;
+#else
+	for(auto &lRect : ground)
+	{
+		lRect.x = (Sint32)read_u32(lRecord);
+		lRect.y = (Sint32)read_u32(lRecord + 4);
+		lRect.w = (Sint32)read_u32(lRecord + 8);
+		lRect.h = (Sint32)read_u32(lRecord + 12);
+		lRecord += RECORD_SIZE;
+	}
+#endif
+
+	entities.resize(lEntityCount);
+	for(auto &lEntity : entities)
+	{
+		lEntity.type = (Sint32)read_u32(lRecord);
+		lEntity.x = (Sint32)read_u32(lRecord + 4);
+		lEntity.y = (Sint32)read_u32(lRecord + 8);
+		lEntity.x_end = (Sint32)read_u32(lRecord + 12);
+		lRecord += RECORD_SIZE;
+	}
+
+	return validate();
+}
+
+/**
+ * validate
+ * \brief Check the parsed map (both forms): one player, one exit, known
+ *        entity types, ground and entities inside MAX_TILES, then size the map
+ * \return boolean : validation status (false if there is an error, the
+ *         errors of the parse included)
+ **/
+bool LevelMap::validate()
+{
+	int lPlayers{0};
+	int lDoors{0};
+	const int lMaxPixels = MAX_TILES * TILE_SIZE;
+
+	for(auto &lRect : ground)
+	{
+		if(lRect.x < 0 || lRect.y < 0 || lRect.w <= 0 || lRect.h <= 0 ||
+			lRect.x > lMaxPixels - lRect.w || lRect.y > lMaxPixels - lRect.h)
+		{
+			errors.push_back("ground rect " + std::to_string(lRect.x) + "," + std::to_string(lRect.y) + " out of the map");
+		}
+	}
+
+	for(auto &lEntity : entities)
+	{
+		if(lEntity.x < 0 || lEntity.y < 0 || lEntity.x >= MAX_TILES || lEntity.y >= MAX_TILES ||
+			lEntity.x_end < lEntity.x || lEntity.x_end >= MAX_TILES)
+		{
+			errors.push_back("entity " + std::to_string(lEntity.x) + "," + std::to_string(lEntity.y) + " out of the map");
+			continue;
+		}
+
+		switch(lEntity.type)
+		{
+			case 'P':
+				if(++lPlayers > 1)
+				{
+					errors.push_back(location(lEntity.y, lEntity.x) + "more than one player");
+				}
+				break;
+			case 'D':
+				if(++lDoors > 1)
+				{
+					errors.push_back(location(lEntity.y, lEntity.x) + "more than one exit");
+				}
+				break;
+			case MONSTER:
+			case 'A':
+			case 'S':
+			case 'F':
+			case 'G':
+			case 'T':
+			case 'C':
+				break;
+			default:
+				errors.push_back(location(lEntity.y, lEntity.x) + "unknown entity type " + std::to_string(lEntity.type));
+				break;
+		}
+	}
+
+	if(lPlayers == 0)
+	{
+		errors.push_back("There is no player in this level map");
+	}
+
+	if(lDoors == 0)
+	{
+		errors.push_back("There is no exit in this level map");
+	}
+
+	if(!errors.empty())
+	{
+		return false;
+	}
+
+	compute_size();
+	return true;
+}
+
+/**
+ * compute_size
+ * \brief Size the map from the extent of its ground and entities (tiles,
+ *        at least one sheet)
+ * \return void
+ **/
+void LevelMap::compute_size()
+{
+	width = SHEET_WIDTH;
+	height = SHEET_HEIGHT;
+
+	for(auto &lRect : ground)
+	{
+		width = SDL_max(width, (lRect.x + lRect.w + TILE_SIZE - 1) / TILE_SIZE);
+		height = SDL_max(height, lRect.y / TILE_SIZE + 1);
+	}
+
+	for(auto &lEntity : entities)
+	{
+		width = SDL_max(width, SDL_max(lEntity.x, lEntity.x_end) + 1);
+		height = SDL_max(height, lEntity.y + 1);
+	}
+}
+
+/**
+ * write_binary
+ * \param pContent : Compiled map (output)
+ * \brief Serialize the map in the compiled form
+ * \return void
+ **/
+void LevelMap::write_binary(std::string& pContent) const
+{
+	pContent.clear();
+	pContent.append("ELVL", 4);
+	write_u32(pContent, VERSION);
+	write_u32(pContent, ground.size());
+	write_u32(pContent, entities.size());
+
+	for(auto &lRect : ground)
+	{
+		write_u32(pContent, lRect.x);
+		write_u32(pContent, lRect.y);
+		write_u32(pContent, lRect.w);
+		write_u32(pContent, lRect.h);
+	}
+
+	for(auto &lEntity : entities)
+	{
+		write_u32(pContent, lEntity.type);
+		write_u32(pContent, lEntity.x);
+		write_u32(pContent, lEntity.y);
+		write_u32(pContent, lEntity.x_end);
+	}
+}
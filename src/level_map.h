@@ -0,0 +1,78 @@
+#ifndef LEVEL_MAP_H
+#define LEVEL_MAP_H
+
+#include <string>
+#include <vector>
+#include <SDL2/SDL.h>
+
+/**
+ * \struct LevelMap
+ * \brief Parsed level map: ground rects and entity table, read from the
+ *        text lvl_map or from its compiled form (levelc)
+ *
+ * Compiled layout (little-endian 32 bits values):
+ *  - header   : "ELVL", version, ground count, entity count
+ *  - ground   : x, y, w, h (pixels, SDL_Rect layout)
+ *  - entities : type (map character, 'M' for monsters), x, y, x end (tiles)
+ *
+ * Maps can be larger than a sheet: the size is the extent of the ground
+ * and of the entities (the same for both forms).
+ **/
+struct LevelMap
+{
+	static const Uint32 VERSION = 1;
+	static const Uint32 HEADER_SIZE = 16;
+	static const Uint32 RECORD_SIZE = 16;
+
+	//Tiles in a sheet (smallest map, one screen)
+	static const int SHEET_WIDTH = 16;
+	static const int SHEET_HEIGHT = 12;
+
+	//Tile size (pixels)
+	static const int TILE_SIZE = 64;
+
+	//Largest map side (tiles, pixel coordinates stay in an int)
+	static const int MAX_TILES = 1 << 16;
+
+	//Ground rect height (pixels, the ground is the top of its tile)
+	static const int GROUND_HEIGHT = 16;
+
+	//Entity type of a monster (its range is written [ ] in the text map)
+	static const char MONSTER = 'M';
+
+	struct Entity
+	{
+		Sint32 type;
+		Sint32 x;
+		Sint32 y;
+		Sint32 x_end;
+	};
+
+	std::vector<SDL_Rect> ground;
+	std::vector<Entity> entities;
+
+	//Map size (tiles, at least one sheet)
+	int width{SHEET_WIDTH};
+	int height{SHEET_HEIGHT};
+
+	//Diagnostics of the last parse ("line:column: message")
+	std::vector<std::string> errors;
+	std::vector<std::string> warnings;
+
+	//Parse and validate a text map
+	bool parse_text(const std::string& pContent);
+
+	//Load and validate a compiled map (ground rects are copied in one block)
+	bool parse_binary(const Uint8* pData, size_t pSize);
+
+	//Check the player, the exit, the entity types and the coordinates, then size the map
+	bool validate();
+
+	//Size the map from its ground and entities
+	void compute_size();
+
+	//Serialize the map in the compiled form
+	void write_binary(std::string& pContent) const;
+};
+
+#endif
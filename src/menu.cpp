@@ -7,14 +7,15 @@
 
 /**
  *load
+ *\param pBgImage : Decoded background image
+ *\param pBtImage : Decoded buttons image
  *\brief Menu loads
  *\return boolean : menu loading status
  * */
-bool Menu::load(SDL_Renderer* pRenderer, std::string pPath)
+bool Menu::load(SDL_Renderer* pRenderer, SDL_Surface* pBgImage, SDL_Surface* pBtImage)
 {	
 	// Background - Init
-	bg_image = IMG_Load((pPath + "assets/menu.png").c_str());
-	bg_texture = SDL_CreateTextureFromSurface(pRenderer, bg_image);
+	bg_texture = SDL_CreateTextureFromSurface(pRenderer, pBgImage);
 	
 
 	// Background - Verify 
@@ -23,29 +24,26 @@ bool Menu::load(SDL_Renderer* pRenderer, std::string pPath)
 		// Background fails
 		return false;
 	}
-
-
-	// Background - Clean
-	SDL_FreeSurface(bg_image);
 	
 
 	// Buttons-
-	bt_start.load(pRenderer, pPath + "assets/bt_sheet.png");
-	bt_exit.load(pRenderer, pPath + "assets/bt_sheet.png");
+	bt_start.load(pRenderer, pBtImage);
+	bt_exit.load(pRenderer, pBtImage);
 
 	return true;
 }
 
 /**
  *display
+ *\param pRenderer : Frame renderer
  *\brief Menu displays itself
  *\return void
  **/
-void Menu::display(SDL_Renderer* pRenderer)
+void Menu::display(GameRenderer* pRenderer)
 {
 	
 	// Background
-	SDL_RenderCopy(pRenderer, bg_texture, &bg_rect, &bg_rect);
+	pRenderer->push(GameRenderer::LAYER_BACKGROUND, bg_texture, bg_rect, bg_rect);
 	
 	// Buttons
 	bt_start.display(pRenderer);
@@ -19,7 +19,6 @@
 class Menu
 {
 	private:
-		SDL_Surface* bg_image;
 		SDL_Texture* bg_texture;
 		SDL_Rect bg_rect;
 
@@ -43,13 +42,13 @@ class Menu
 		}
 
 		//Create the texture from surface
-		bool load(SDL_Renderer* pRenderer, std::string pPath);
+		bool load(SDL_Renderer* pRenderer, SDL_Surface* pBgImage, SDL_Surface* pBtImage);
 
 		//Unload the menu
 		void dispose();
 
 		//Display the menu
-		void display(SDL_Renderer* pRenderer);
+		void display(GameRenderer* pRenderer);
 
 		//Check if the given button has been clicked
 		bool check_bt_click(int pMouseX, int pMouseY, SDL_Rect* pBtRect);
@@ -3,33 +3,31 @@
 /**
  * load
  * \param pRenderer : Game renderer 
- * \param pPath : Menu button image path
+ * \param pImage : Decoded menu button image
  * \return boolean : load menu button success
  **/
-bool MenuButton::load(SDL_Renderer* pRenderer, std::string pPath)
+bool MenuButton::load(SDL_Renderer* pRenderer, SDL_Surface* pImage)
 {	
 	//Initialize background texture
-	SDL_Surface* bg_image = IMG_Load(pPath.c_str());
-	bg_texture = SDL_CreateTextureFromSurface(pRenderer, bg_image);
+	bg_texture = SDL_CreateTextureFromSurface(pRenderer, pImage);
 	if(bg_texture <= 0)
 	{
 		std::cerr << "Cannot load button background" << std::endl;
 		return false;
 	}
-	SDL_FreeSurface(bg_image);
 	
 	return true;
 }
 
 /**
  * display
- * \param pRenderer : Game renderer
+ * \param pRenderer : Frame renderer
  * \brief display menu button 
  * \return void
  **/
-void MenuButton::display(SDL_Renderer* pRenderer)
+void MenuButton::display(GameRenderer* pRenderer)
 {
-	SDL_RenderCopy(pRenderer, bg_texture, &bg_rect, &bg_pos_rect);
+	pRenderer->push(GameRenderer::LAYER_HUD, bg_texture, bg_rect, bg_pos_rect);
 }
 
 /**
@@ -4,6 +4,7 @@
 #include <iostream>
 #include <string>
 #include <SDL2/SDL.h>
+#include "game_renderer.h"
 
 #ifdef __APPLE__
 #include <SDL2_image/SDL_image.h>
@@ -41,7 +42,7 @@ class MenuButton
 		}
 
 		//Create the texture from surface
-		bool load(SDL_Renderer* pRenderer, std::string pPath);
+		bool load(SDL_Renderer* pRenderer, SDL_Surface* pImage);
 
 		//Return rect
 		SDL_Rect* get_rect(){return &bg_pos_rect;}
@@ -50,7 +51,7 @@ class MenuButton
 		void dispose();
 
 		//Display the menu
-		void display(SDL_Renderer* pRenderer);
+		void display(GameRenderer* pRenderer);
 };
 
 #endif
@@ -2,19 +2,19 @@
 
 /**
  * load 
+ * \param pRenderer : Game renderer
+ * \param pImage : Decoded mouse cursor image
  * \brief load mouse cursor
  * \return boolean : load mouse cursor status
  **/
-bool MouseCursor::load(SDL_Renderer* pRenderer, std::string pPath)
+bool MouseCursor::load(SDL_Renderer* pRenderer, SDL_Surface* pImage)
 {	
 	//Initialize background texture
-	SDL_Surface* mouse_image = IMG_Load((pPath + "assets/eraser.png").c_str());
-	mouse_texture = SDL_CreateTextureFromSurface(pRenderer, mouse_image);
+	mouse_texture = SDL_CreateTextureFromSurface(pRenderer, pImage);
 	if(mouse_texture <= 0)
 	{
 		return false;
 	}
-	SDL_FreeSurface(mouse_image);
 
 	//Hide the cursor
 	SDL_ShowCursor(SDL_DISABLE);
@@ -24,16 +24,17 @@ bool MouseCursor::load(SDL_Renderer* pRenderer, std::string pPath)
 
 /**
  * display 
- * \brief display mouse cursor
+ * \param pRenderer : Frame renderer
+ * \brief display mouse cursor (on top of every layer)
  * \return boolean : display mouse cursor status
  **/
-void MouseCursor::display(SDL_Renderer* pRenderer)
+void MouseCursor::display(GameRenderer* pRenderer)
 {
 	//Update position x/y
 	SDL_GetMouseState(&mouse_pos_rect.x, &mouse_pos_rect.y);
 
 	//Display the cursor
-	SDL_RenderCopy(pRenderer, mouse_texture, &mouse_rect, &mouse_pos_rect);	
+	pRenderer->push(GameRenderer::LAYER_CURSOR, mouse_texture, mouse_rect, mouse_pos_rect);	
 }
 
 
@@ -3,6 +3,7 @@
 
 #include <string>
 #include <SDL2/SDL.h>
+#include "game_renderer.h"
 
 #ifdef __APPLE__
 #include <SDL2_image/SDL_image.h>
@@ -17,7 +18,6 @@
 class MouseCursor
 {
 	private:
-		SDL_Surface* mouse_image;
 		SDL_Texture* mouse_texture;
 		SDL_Rect mouse_rect;
 		SDL_Rect mouse_pos_rect;
@@ -37,13 +37,13 @@ class MouseCursor
 		}
 
 		//Create the texture from surface
-		bool load(SDL_Renderer* pRenderer, std::string pPath);
+		bool load(SDL_Renderer* pRenderer, SDL_Surface* pImage);
 
 		//Unload the menu
 		void dispose();
 
 		//Display the menu
-		void display(SDL_Renderer* pRenderer);
+		void display(GameRenderer* pRenderer);
 };
 
 #endif
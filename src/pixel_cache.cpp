@@ -0,0 +1,275 @@
+#include "pixel_cache.h"
+#include "asset_archive.h"
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+/**
+ * read_u32
+ * \param pFile : Cache file
+ * \param pValue : Value (output)
+ * \brief Read a little-endian 32 bits value
+ * \return boolean : read status
+ **/
+static bool read_u32(SDL_RWops* pFile, Uint32* pValue)
+{
+	Uint8 lBytes[4];
+	if(SDL_RWread(pFile, lBytes, 4, 1) != 1)
+	{
+		return false;
+	}
+	*pValue = (Uint32)lBytes[0] | ((Uint32)lBytes[1] << 8) | ((Uint32)lBytes[2] << 16) | ((Uint32)lBytes[3] << 24);
+	return true;
+}
+
+/**
+ * write_u32
+ * \param pFile : Cache file
+ * \param pValue : Value
+ * \brief Write a little-endian 32 bits value
+ * \return boolean : write status
+ **/
+static bool write_u32(SDL_RWops* pFile, Uint32 pValue)
+{
+	Uint8 lBytes[4] = {(Uint8)(pValue & 0xFF), (Uint8)((pValue >> 8) & 0xFF), (Uint8)((pValue >> 16) & 0xFF), (Uint8)((pValue >> 24) & 0xFF)};
+	return SDL_RWwrite(pFile, lBytes, 4, 1) == 1;
+}
+
+/**
+ * init
+ * \param pRenderer : Game renderer
+ * \param pVfs : Game files
+ * \brief Pick the renderer texture format (with alpha if possible) and the cache directory
+ * \return boolean : cache enabled status
+ **/
+bool PixelCache::init(SDL_Renderer* pRenderer, Vfs* pVfs)
+{
+	vfs = pVfs;
+	format = SDL_PIXELFORMAT_UNKNOWN;
+
+	SDL_RendererInfo lInfo;
+	if(SDL_GetRendererInfo(pRenderer, &lInfo) < 0 || lInfo.num_texture_formats == 0)
+	{
+		return false;
+	}
+
+	format = lInfo.texture_formats[0];
+	for(Uint32 lIdx = 0; lIdx < lInfo.num_texture_formats; lIdx++)
+	{
+		Uint32 lFormat = lInfo.texture_formats[lIdx];
+		if(SDL_ISPIXELFORMAT_ALPHA(lFormat) && !SDL_ISPIXELFORMAT_FOURCC(lFormat))
+		{
+			format = lFormat;
+			break;
+		}
+	}
+
+	char* lPrefPath = SDL_GetPrefPath("LD32", "Eraser");
+	if(lPrefPath == nullptr)
+	{
+		std::cerr << "No pixel cache directory: " << SDL_GetError() << std::endl;
+		return false;
+	}
+	cache_path = lPrefPath;
+	SDL_free(lPrefPath);
+
+	return true;
+}
+
+/**
+ * get_key
+ * \param pId : Image
+ * \brief Cache key of an image (name, source modification time, pixel format)
+ * \return std::string : cache key
+ **/
+std::string PixelCache::get_key(AssetId pId)
+{
+	return vfs->get_name(pId) + ":" + std::to_string(vfs->get_stamp(pId)) + ":" + SDL_GetPixelFormatName(format);
+}
+
+/**
+ * get_file_path
+ * \param pId : Image
+ * \brief Cache file of an image, named after the hash of its name and the
+ *        pixel format only (a rebuilt image overwrites its outdated file)
+ * \return std::string : cache file path
+ **/
+std::string PixelCache::get_file_path(AssetId pId)
+{
+	char lName[32];
+	snprintf(lName, sizeof(lName), "px_%08x.bin", AssetArchive::hash(vfs->get_name(pId) + ":" + SDL_GetPixelFormatName(format)));
+	return cache_path + lName;
+}
+
+/**
+ * load
+ * \param pId : Image
+ * \brief Load a cached image (read straight into the surface pixels)
+ * \return SDL_Surface* : image in the texture format (nullptr if missing or outdated)
+ **/
+SDL_Surface* PixelCache::load(AssetId pId)
+{
+	if(!is_enabled() || !vfs->exists(pId))
+	{
+		return nullptr;
+	}
+
+	std::string lKey = get_key(pId);
+	std::string lPath = get_file_path(pId);
+	SDL_RWops* lFile = SDL_RWFromFile(lPath.c_str(), "rb");
+	if(lFile == nullptr)
+	{
+		return nullptr;
+	}
+
+	char lMagic[4];
+	Uint32 lVersion{0};
+	Uint32 lKeySize{0};
+	if(SDL_RWread(lFile, lMagic, 4, 1) != 1 || memcmp(lMagic, "EPIX", 4) != 0 ||
+		!read_u32(lFile, &lVersion) || lVersion != VERSION ||
+		!read_u32(lFile, &lKeySize) || lKeySize != lKey.size())
+	{
+		SDL_RWclose(lFile);
+		return nullptr;
+	}
+
+	//Outdated image (or same hash, other image): written again by store
+	std::vector<char> lStoredKey(lKeySize);
+	if(lKeySize > 0 && (SDL_RWread(lFile, lStoredKey.data(), lKeySize, 1) != 1 || lKey.compare(0, lKeySize, lStoredKey.data(), lKeySize) != 0))
+	{
+		SDL_RWclose(lFile);
+		return nullptr;
+	}
+
+	Uint32 lFormat, lWidth, lHeight, lPitch, lBlendMode;
+	if(!read_u32(lFile, &lFormat) || !read_u32(lFile, &lWidth) || !read_u32(lFile, &lHeight) ||
+		!read_u32(lFile, &lPitch) || !read_u32(lFile, &lBlendMode) || lFormat != format)
+	{
+		SDL_RWclose(lFile);
+		return nullptr;
+	}
+
+	SDL_Surface* lImage = SDL_CreateRGBSurfaceWithFormat(0, lWidth, lHeight, SDL_BITSPERPIXEL(format), format);
+	if(lImage == nullptr || (Uint32)lImage->pitch != lPitch ||
+		(lHeight > 0 && SDL_RWread(lFile, lImage->pixels, lPitch, lHeight) != lHeight))
+	{
+		SDL_FreeSurface(lImage);
+		SDL_RWclose(lFile);
+		return nullptr;
+	}
+	SDL_RWclose(lFile);
+
+	SDL_SetSurfaceBlendMode(lImage, (SDL_BlendMode)lBlendMode);
+	return lImage;
+}
+
+/**
+ * store
+ * \param pId : Image
+ * \param pImage : Decoded image (freed)
+ * \brief Convert a decoded image to the texture format and write it in the cache
+ * \return SDL_Surface* : image in the texture format (the decoded one if the cache is disabled)
+ **/
+SDL_Surface* PixelCache::store(AssetId pId, SDL_Surface* pImage)
+{
+	if(!is_enabled() || pImage == nullptr)
+	{
+		return pImage;
+	}
+
+	//Images with alpha or a color key are blended (as SDL_CreateTextureFromSurface does)
+	SDL_BlendMode lBlendMode = SDL_BLENDMODE_NONE;
+	if(pImage->format->Amask != 0 || SDL_GetColorKey(pImage, nullptr) == 0)
+	{
+		lBlendMode = SDL_BLENDMODE_BLEND;
+	}
+
+	SDL_Surface* lImage = SDL_ConvertSurfaceFormat(pImage, format, 0);
+	if(lImage == nullptr)
+	{
+		return pImage;
+	}
+	SDL_FreeSurface(pImage);
+	SDL_SetSurfaceBlendMode(lImage, lBlendMode);
+
+	std::string lKey = get_key(pId);
+	std::string lPath = get_file_path(pId);
+	SDL_RWops* lFile = SDL_RWFromFile(lPath.c_str(), "wb");
+	if(lFile == nullptr)
+	{
+		return lImage;
+	}
+
+	bool lStatus = SDL_RWwrite(lFile, "EPIX", 4, 1) == 1 &&
+		write_u32(lFile, VERSION) &&
+		write_u32(lFile, lKey.size()) &&
+		SDL_RWwrite(lFile, lKey.data(), lKey.size(), 1) == 1 &&
+		write_u32(lFile, format) &&
+		write_u32(lFile, lImage->w) &&
+		write_u32(lFile, lImage->h) &&
+		write_u32(lFile, lImage->pitch) &&
+		write_u32(lFile, lBlendMode) &&
+		(lImage->h == 0 || SDL_RWwrite(lFile, lImage->pixels, lImage->pitch, lImage->h) == (size_t)lImage->h);
+	SDL_RWclose(lFile);
+
+	if(!lStatus)
+	{
+		std::cerr << "Cannot write pixel cache: " + lPath << std::endl;
+		remove(lPath.c_str());
+	}
+	return lImage;
+}
+
+/**
+ * create_texture
+ * \param pRenderer : Game renderer
+ * \param pImage : Image
+ * \brief Create a texture from an image, an image already in a texture format
+ *        is uploaded as is with SDL_UpdateTexture (no conversion)
+ * \return SDL_Texture* : texture (nullptr on failure)
+ **/
+SDL_Texture* PixelCache::create_texture(SDL_Renderer* pRenderer, SDL_Surface* pImage)
+{
+	if(pImage == nullptr)
+	{
+		return nullptr;
+	}
+
+	//Images in another format are converted by SDL
+	bool lIsNative = false;
+	SDL_RendererInfo lInfo;
+	if(SDL_GetRendererInfo(pRenderer, &lInfo) == 0)
+	{
+		for(Uint32 lIdx = 0; lIdx < lInfo.num_texture_formats; lIdx++)
+		{
+			if(lInfo.texture_formats[lIdx] == pImage->format->format)
+			{
+				lIsNative = true;
+			}
+		}
+	}
+
+	if(!lIsNative || SDL_MUSTLOCK(pImage))
+	{
+		return SDL_CreateTextureFromSurface(pRenderer, pImage);
+	}
+
+	SDL_Texture* lTexture = SDL_CreateTexture(pRenderer, pImage->format->format, SDL_TEXTUREACCESS_STATIC, pImage->w, pImage->h);
+	if(lTexture == nullptr)
+	{
+		return SDL_CreateTextureFromSurface(pRenderer, pImage);
+	}
+
+	if(SDL_UpdateTexture(lTexture, nullptr, pImage->pixels, pImage->pitch) < 0)
+	{
+		SDL_DestroyTexture(lTexture);
+		return SDL_CreateTextureFromSurface(pRenderer, pImage);
+	}
+
+	SDL_BlendMode lBlendMode;
+	SDL_GetSurfaceBlendMode(pImage, &lBlendMode);
+	SDL_SetTextureBlendMode(lTexture, lBlendMode);
+
+	return lTexture;
+}
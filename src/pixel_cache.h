@@ -0,0 +1,59 @@
+#ifndef PIXEL_CACHE_H
+#define PIXEL_CACHE_H
+
+#include <string>
+#include <SDL2/SDL.h>
+#include "vfs.h"
+
+/**
+ * \class PixelCache
+ * \brief On-disk cache of decoded images, already converted to the
+ *        renderer texture format (no PNG decode nor conversion on hit)
+ *
+ * One file per image in the SDL preferences directory, named after the
+ * hash of "name:pixel format" and checked against the stored key
+ * "name:modification time:pixel format" (a rebuilt image replaces its file):
+ *  - header : "EPIX", version, key size, key, format, width, height,
+ *             pitch, blend mode (little-endian 32 bits values)
+ *  - pixels : height * pitch bytes
+ **/
+class PixelCache
+{
+	private:
+		Vfs* vfs;
+		std::string cache_path;
+		Uint32 format;
+
+		//Cache key of an image
+		std::string get_key(AssetId pId);
+
+		//Cache file of an image
+		std::string get_file_path(AssetId pId);
+
+	public:
+		static const Uint32 VERSION = 1;
+
+		//Constructor
+		PixelCache()
+		{
+			vfs = nullptr;
+			format = SDL_PIXELFORMAT_UNKNOWN;
+		}
+
+		//Pick the renderer texture format and the cache directory
+		bool init(SDL_Renderer* pRenderer, Vfs* pVfs);
+
+		//Check if the cache can be used
+		bool is_enabled(){return format != SDL_PIXELFORMAT_UNKNOWN && !cache_path.empty();}
+
+		//Load a cached image (nullptr if missing or outdated)
+		SDL_Surface* load(AssetId pId);
+
+		//Convert a decoded image to the texture format and store it (the decoded image is freed)
+		SDL_Surface* store(AssetId pId, SDL_Surface* pImage);
+
+		//Create a texture from an image, uploaded as is when it is in a texture format
+		static SDL_Texture* create_texture(SDL_Renderer* pRenderer, SDL_Surface* pImage);
+};
+
+#endif
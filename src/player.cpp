@@ -2,38 +2,31 @@
 
 /**
  * init_texture
- * \param pRenderer : Game renderer
- * \brief Initialize texture
+ * \param pSheet : Shared sprite sheet
+ * \brief Set the shared texture
  * \return boolean : init player texture status
  **/
-bool Player::init_texture(SDL_Renderer* pRenderer)
+bool Player::init_texture(SpriteSheet pSheet)
 {
-	SDL_Surface* player_image = IMG_Load(player_image_path.c_str());
-	player_texture = SDL_CreateTextureFromSurface(pRenderer, player_image);
-	if(player_texture <= 0)
+	player_sheet = pSheet;
+	if(player_sheet.texture == nullptr)
 	{	
 		return false;
 	}
-	SDL_FreeSurface(player_image);
 	return true;
 }
 
 /**
  * render
- * \param pRenderer : Game renderer
- * \brief Render the texture through given renderer
+ * \param pRenderer : Frame renderer
+ * \param pAlpha : Time since the last simulation step (fraction of a step)
+ * \brief Add the sprite to the frame renderer (mirrored when going right)
  * \return void
  **/
-void Player::render(SDL_Renderer* pRenderer)
+void Player::render(GameRenderer* pRenderer, float pAlpha)
 {
-	if(player_direction == LEFT)
-	{
-		SDL_RenderCopy(pRenderer, player_texture, &sprite_rect, &player_rect);
-	}
-	else
-	{
-		SDL_RenderCopyEx(pRenderer, player_texture, &sprite_rect, &player_rect, 0, nullptr, SDL_FLIP_HORIZONTAL);
-	}
+	SDL_Rect lSrc = player_sheet.frame(sprite_rect);
+	pRenderer->push(GameRenderer::LAYER_PLAYER, player_sheet.texture, lSrc, get_render_rect(pAlpha), player_direction != LEFT);
 }
 
 /**
@@ -83,45 +76,6 @@ void Player::move_x(int step=1)
 	player_rect.x = pos.get_x() * STEP_X;
 }
 
-/**
- * fall
- * \param ground : player walks on this ground 
- * \brief PLayer fall
- * \return boolean : player falling boolean 
- **/
-bool Player::fall(std::vector<SDL_Rect> ground)
-{
-	//Update the rect
-	pos.set_y(pos.get_y()+1);
-	player_rect.y = pos.get_y() * STEP_Y;
-			
-	if(has_intersection(ground))
-	{
-		pos.set_y(pos.get_y()-1);
-		player_rect.y = pos.get_y() * STEP_Y;
-		return false;
-	}
-	return true;
-}
-
-/**
- * has_intersection
- * \param sdl_rect_vector
- * \brief check if player rect intersects 
- * \return boolean : player intersection boolean
- **/
-bool Player::has_intersection(std::vector<SDL_Rect> sdl_rect_vector)
-{
-	for(auto lRect : sdl_rect_vector)
-	{
-		if(SDL_HasIntersection(&player_rect, &lRect))
-		{
-			return true;			
-		}
-	}
-	return false;
-}
-
 /**
  * move_y
  * \param step (default value is 1)
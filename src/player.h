@@ -2,6 +2,8 @@
 #define PLAYER_H
 
 #include "position.h"
+#include "sprite_sheet.h"
+#include "game_renderer.h"
 #include <string>
 #include <vector>
 #include <SDL2/SDL.h>
@@ -19,10 +21,11 @@
 class Player
 {
 	Position pos;
-	std::string player_image_path;
-	SDL_Texture* player_texture;
+	SpriteSheet player_sheet;
 	SDL_Rect sprite_rect;
 	SDL_Rect player_rect;
+	//Rect at the previous simulation step (drawn interpolated)
+	SDL_Rect last_rect;
 	int player_direction;
 	bool is_jump = false;	
 	bool is_dead = false;
@@ -40,11 +43,10 @@ class Player
 		static const int RIGHT = 1;
 
 		//Constructors
-		Player(std::string pSpritePath="", int pX=0, int pY=0)
+		Player(int pX=0, int pY=0)
 		{
 			pos = Position(pX, pY);
 
-			player_image_path = pSpritePath;
 			player_direction = RIGHT;
 
 			sprite_rect.w = 32;
@@ -56,16 +58,18 @@ class Player
 			player_rect.h = sprite_rect.h;
 			player_rect.x = pX * STEP_X;
 			player_rect.y = pY * STEP_Y;
+
+			last_rect = player_rect;
 		}
 
 		//Getter for player_rect (will be used for collsion)
 		SDL_Rect* get_rect(){ return &player_rect; }
 
-		//Initialize texture
-		bool init_texture(SDL_Renderer* pRenderer);
+		//Set the shared sprite sheet
+		bool init_texture(SpriteSheet pSheet);
 
 		//Getter for player texture
-		SDL_Texture* get_texture(){return player_texture;}
+		SDL_Texture* get_texture(){return player_sheet.texture;}
 
 		void jump(){is_jump=true;}
 	
@@ -76,6 +80,9 @@ class Player
 		//Set the player position to the given position
 		void set_pos(Position pPosition);
 
+		//Getter for the player position (tiles)
+		Position get_pos(){return pos;}
+
 		//Kill the player
 		void kill(){is_dead = true;}
 
@@ -85,19 +92,19 @@ class Player
 		//Check if player is alive
 		bool is_alive(){return !is_dead;}
 
-		//Render the texture through given renderer
-		void render(SDL_Renderer* pRenderer);
+		//Keep the rect of the previous simulation step
+		void save_rect(){last_rect = player_rect;}
+
+		//Getter for the drawn rect, between the previous and the last step
+		SDL_Rect get_render_rect(float pAlpha){return GameRenderer::interpolate(last_rect, player_rect, pAlpha);}
+
+		//Add the sprite to the frame renderer (between the previous and the last step)
+		void render(GameRenderer* pRenderer, float pAlpha=1.0f);
 
 		//Move on X axis 
 		void move_x(int step);
 
 		//Move on Y axis
 		void move_y(int step);
-
-		//Let the user falls if he's not on the groud
-		bool fall(std::vector<SDL_Rect> ground);
-
-		//Check if player has instersection with given SDL_Rects
-		bool has_intersection(std::vector<SDL_Rect> sdl_rect_vector);
 };
 #endif
@@ -27,10 +27,7 @@ int Position::get_y()
  **/
 void Position::set_x(int pX=0)
 {
-	if(pX >= MIN_X && pX <= MAX_X)
-	{	
-		coord_x = pX;
-	}
+	coord_x = pX;
 }
 
 /**
@@ -40,9 +37,6 @@ void Position::set_x(int pX=0)
  **/
 void Position::set_y(int pY=0)
 {
-	if(pY >= MIN_Y && pY <= MAX_Y)
-	{
-		coord_y = pY;
-	}
+	coord_y = pY;
 }
 
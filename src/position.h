@@ -3,7 +3,8 @@
 
 /**
  * \class Position
- * \brief A class to manage game objects position
+ * \brief A class to manage game objects position (tiles, the level keeps
+ *        the player inside its map)
  **/
 class Position
 {
@@ -11,11 +12,6 @@ class Position
       	int coord_y;	
 
 	public:
-		static const int MIN_X = 0;
-		static const int MAX_X = 15;
-		static const signed int MIN_Y = 0;
-		static const int MAX_Y = 12;
-
 		//Constructor
 		Position(int pX=0, int pY=0)
 		{
@@ -0,0 +1,230 @@
+#include "render_queue.h"
+#include "text_renderer.h"
+#include <algorithm>
+#include <functional>
+
+/**
+ * push
+ * \param pLayer : Layer (GameRenderer::LAYER_*)
+ * \param pTexture : Sprite texture
+ * \param pSrc : Area of the texture
+ * \param pDst : Area of the screen
+ * \param pIsFlipped : Mirror the sprite horizontally
+ * \param pColor : Tint (white to keep the texture colors)
+ * \brief Add a render command to the frame
+ * \return void
+ **/
+void RenderQueue::push(int pLayer, SDL_Texture* pTexture, const SDL_Rect& pSrc, const SDL_Rect& pDst, bool pIsFlipped, SDL_Color pColor)
+{
+	if(pTexture == nullptr)
+	{
+		return;
+	}
+	commands.push_back({pLayer, pTexture, pSrc, pDst, pColor, pIsFlipped});
+}
+
+/**
+ * draw_text
+ * \param pText : Text
+ * \param pX : Position X (pixels)
+ * \param pY : Position Y (pixels)
+ * \param pColor : Text color
+ * \param pWrapWidth : Wrap width (pixels, 0 to only break lines on '\n')
+ * \brief Add the glyph commands of a text (nothing without a glyph atlas)
+ * \return void
+ **/
+void RenderQueue::draw_text(const char* pText, int pX, int pY, SDL_Color pColor, int pWrapWidth)
+{
+	if(text != nullptr)
+	{
+		text->draw(this, pText, pX, pY, pColor, pWrapWidth);
+	}
+}
+
+/**
+ * sort
+ * \brief Sort the commands by layer then texture (stable, so the sprites of a
+ *        texture keep their order)
+ * \return void
+ **/
+void RenderQueue::sort()
+{
+	std::stable_sort(commands.begin(), commands.end(), [](const Command& pLeft, const Command& pRight)
+	{
+		if(pLeft.layer != pRight.layer)
+		{
+			return pLeft.layer < pRight.layer;
+		}
+		return std::less<SDL_Texture*>()(pLeft.texture, pRight.texture);
+	});
+}
+
+/**
+ * batch_area
+ * \param pArea : Area of the screen (nullptr for the whole screen)
+ * \brief Add the sorted commands intersecting the area to the batch
+ * \return void
+ **/
+void RenderQueue::batch_area(const SDL_Rect* pArea)
+{
+	for(auto &lCommand : commands)
+	{
+		if(pArea == nullptr || SDL_HasIntersection(pArea, &lCommand.dst))
+		{
+			batch.add(lCommand.texture, lCommand.src, lCommand.dst, lCommand.is_flipped, lCommand.color);
+		}
+	}
+}
+
+/**
+ * submit
+ * \param pRenderer : Game renderer
+ * \brief Sort the commands and draw them, one batch run per texture of a layer
+ * \return void
+ **/
+void RenderQueue::submit(SDL_Renderer* pRenderer)
+{
+	sort();
+
+	batch.begin();
+	batch_area(nullptr);
+	batch.flush(pRenderer);
+
+	drawn.swap(commands);
+	commands.clear();
+}
+
+/**
+ * is_same
+ * \param pLeft : Command
+ * \param pRight : Command
+ * \brief Check if two commands draw the same pixels
+ * \return boolean : same command status
+ **/
+bool RenderQueue::is_same(const Command& pLeft, const Command& pRight)
+{
+	return pLeft.layer == pRight.layer && pLeft.texture == pRight.texture &&
+		SDL_RectEquals(&pLeft.src, &pRight.src) && SDL_RectEquals(&pLeft.dst, &pRight.dst) &&
+		pLeft.is_flipped == pRight.is_flipped &&
+		pLeft.color.r == pRight.color.r && pLeft.color.g == pRight.color.g &&
+		pLeft.color.b == pRight.color.b && pLeft.color.a == pRight.color.a;
+}
+
+/**
+ * add_damage
+ * \param pRect : Area to redraw
+ * \brief Add an area to redraw, merged with the areas it intersects
+ * \return void
+ **/
+void RenderQueue::add_damage(SDL_Rect pRect)
+{
+	for(size_t lIdx = 0; lIdx < damage.size();)
+	{
+		if(SDL_HasIntersection(&damage[lIdx], &pRect))
+		{
+			SDL_UnionRect(&damage[lIdx], &pRect, &pRect);
+			damage.erase(damage.begin() + lIdx);
+			lIdx = 0;
+		}
+		else
+		{
+			lIdx++;
+		}
+	}
+	damage.push_back(pRect);
+}
+
+/**
+ * submit_damaged
+ * \param pRenderer : Game renderer (software renderer of the window surface)
+ * \brief Sort the commands, find the areas where they differ from the previous
+ *        frame (moved, animated, added or removed sprites) and redraw only these
+ *        areas (the whole screen when too much changed)
+ * \return const std::vector<SDL_Rect>& : redrawn areas, drawn already (renderer flushed),
+ *         to present with SDL_UpdateWindowSurfaceRects
+ **/
+const std::vector<SDL_Rect>& RenderQueue::submit_damaged(SDL_Renderer* pRenderer)
+{
+	sort();
+	damage.clear();
+
+	SDL_Rect lScreen = {0, 0, 0, 0};
+	SDL_GetRendererOutputSize(pRenderer, &lScreen.w, &lScreen.h);
+
+	if(!is_full_damage)
+	{
+		//Commands drawn at the same place in both frames are matched once
+		std::vector<bool> lIsMatched(drawn.size(), false);
+		for(size_t lIdx = 0; lIdx < commands.size(); lIdx++)
+		{
+			bool lIsFound = false;
+			if(lIdx < drawn.size() && !lIsMatched[lIdx] && is_same(commands[lIdx], drawn[lIdx]))
+			{
+				lIsMatched[lIdx] = true;
+				lIsFound = true;
+			}
+
+			for(size_t lOld = 0; !lIsFound && lOld < drawn.size(); lOld++)
+			{
+				if(!lIsMatched[lOld] && is_same(commands[lIdx], drawn[lOld]))
+				{
+					lIsMatched[lOld] = true;
+					lIsFound = true;
+				}
+			}
+
+			if(!lIsFound)
+			{
+				add_damage(commands[lIdx].dst);
+			}
+		}
+
+		for(size_t lOld = 0; lOld < drawn.size(); lOld++)
+		{
+			if(!lIsMatched[lOld])
+			{
+				add_damage(drawn[lOld].dst);
+			}
+		}
+
+		//Clip to the screen, too many or too large areas: full frame
+		int lArea{0};
+		for(size_t lIdx = 0; lIdx < damage.size();)
+		{
+			if(!SDL_IntersectRect(&damage[lIdx], &lScreen, &damage[lIdx]))
+			{
+				damage.erase(damage.begin() + lIdx);
+				continue;
+			}
+			lArea += damage[lIdx].w * damage[lIdx].h;
+			lIdx++;
+		}
+		is_full_damage = (int)damage.size() > MAX_DAMAGE_RECTS || lArea > lScreen.w * lScreen.h / 2;
+	}
+
+	if(is_full_damage)
+	{
+		damage.assign(1, lScreen);
+	}
+
+	//Each area is cleared and recomposed from every command it intersects
+	for(auto &lRect : damage)
+	{
+		SDL_RenderSetClipRect(pRenderer, &lRect);
+		SDL_RenderFillRect(pRenderer, &lRect);
+
+		batch.begin();
+		batch_area(&lRect);
+		batch.flush(pRenderer);
+	}
+	SDL_RenderSetClipRect(pRenderer, nullptr);
+
+	//Batched draws executed before the window surface is presented (no SDL_RenderPresent here)
+	SDL_RenderFlush(pRenderer);
+
+	is_full_damage = false;
+	drawn.swap(commands);
+	commands.clear();
+
+	return damage;
+}
@@ -0,0 +1,98 @@
+#ifndef RENDER_QUEUE_H
+#define RENDER_QUEUE_H
+
+#include <vector>
+#include <SDL2/SDL.h>
+#include "sprite_batch.h"
+#include "game_renderer.h"
+
+class TextRenderer;
+
+/**
+ * \class RenderQueue
+ * \brief Render commands of a frame, sorted by layer then texture before
+ *        being submitted through the sprite batch (the drawing order comes
+ *        from the layers, not from the order of the render calls)
+ *
+ * Commands of the same layer and texture keep their submission order.
+ *
+ * Damage mode (software renderer drawing into the window surface): the
+ * commands are compared with the ones of the previous frame, only the areas
+ * of the changed commands are redrawn and given back to be presented.
+ **/
+class RenderQueue : public GameRenderer
+{
+	private:
+		struct Command
+		{
+			int layer;
+			SDL_Texture* texture;
+			SDL_Rect src;
+			SDL_Rect dst;
+			SDL_Color color;
+			bool is_flipped;
+		};
+
+		//Above this, the whole frame is redrawn
+		static const int MAX_DAMAGE_RECTS = 16;
+
+		std::vector<Command> commands;
+		SpriteBatch batch;
+
+		//Commands of the last submitted frame, areas redrawn by submit_damaged
+		std::vector<Command> drawn;
+		std::vector<SDL_Rect> damage;
+		bool is_full_damage;
+
+		//Sort the commands by layer then texture
+		void sort();
+
+		//Add the commands intersecting an area (every command if nullptr) to the batch
+		void batch_area(const SDL_Rect* pArea);
+
+		//Add an area to redraw (merged with the areas it intersects)
+		void add_damage(SDL_Rect pRect);
+
+		//Compare two commands
+		static bool is_same(const Command& pLeft, const Command& pRight);
+
+		//Glyph atlas of the texts
+		TextRenderer* text;
+
+	public:
+		//Constructor
+		RenderQueue()
+		{
+			text = nullptr;
+			is_full_damage = true;
+		}
+
+		//Set the glyph atlas used by draw_text
+		void set_text(TextRenderer* pText){text = pText;}
+
+		//Add a render command (mirrored horizontally if flipped, tinted by the color)
+		void push(int pLayer, SDL_Texture* pTexture, const SDL_Rect& pSrc, const SDL_Rect& pDst, bool pIsFlipped=false, SDL_Color pColor={255, 255, 255, 255}) override;
+
+		//Add the glyph commands of a text
+		void draw_text(const char* pText, int pX, int pY, SDL_Color pColor, int pWrapWidth=0) override;
+
+		//Drop the commands of the frame (the screen is drawn at once elsewhere, the next frame is redrawn fully)
+		void clear() override {commands.clear(); is_full_damage = true;}
+
+		//Redraw the whole next frame in damage mode (window exposed, textures re-created or re-composed)
+		void invalidate() override {is_full_damage = true;}
+
+		//Sort and draw the commands of the frame
+		void submit(SDL_Renderer* pRenderer);
+
+		//Sort the commands and redraw only the areas that changed since the last frame
+		const std::vector<SDL_Rect>& submit_damaged(SDL_Renderer* pRenderer);
+
+		//Getter for the draw calls of the last submitted frame
+		int get_draw_calls(){return batch.get_draw_calls();}
+
+		//Getter for the sprites of the last submitted frame
+		int get_sprite_count(){return batch.get_sprite_count();}
+};
+
+#endif
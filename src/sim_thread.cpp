@@ -0,0 +1,149 @@
+#include "sim_thread.h"
+
+/**
+ * start
+ * \param pLevel : Loaded level
+ * \brief Publish a first tick, then simulate the level on the thread
+ * \return void
+ **/
+void SimThread::start(Level* pLevel)
+{
+	stop();
+
+	level = pLevel;
+	is_stopping = false;
+
+	//Inputs of the previous level are dropped
+	SDL_Event lEvent;
+	while(inputs.pop(lEvent))
+	{
+	}
+
+	//The commands of a snapshot may still be drawn after a texture release
+	level->set_deferred_release(true);
+
+	//The static layer is composed by the render thread (the snapshots of the
+	//previous level are recorded again)
+	level->set_static_remote(true);
+	level_static_stamp = level->get_static_stamp();
+	static_stamp++;
+
+	if(tick() == Level::PLAYING)
+	{
+		thread = std::thread(&SimThread::run, this);
+	}
+}
+
+/**
+ * stop
+ * \brief Stop the simulation and wait for the thread
+ * \return void
+ **/
+void SimThread::stop()
+{
+	is_stopping = true;
+	if(thread.joinable())
+	{
+		thread.join();
+	}
+}
+
+/**
+ * run
+ * \brief Simulate a tick every TICK_TIME ms until the level is over or stopped,
+ *        wait without ticking while paused (no catch-up on resume)
+ * \return void
+ **/
+void SimThread::run()
+{
+	Uint32 lNextTick = SDL_GetTicks() + TICK_TIME;
+	while(!is_stopping)
+	{
+		if(is_paused)
+		{
+			Uint32 lPauseStart = SDL_GetTicks();
+			while(is_paused && !is_stopping)
+			{
+				SDL_Delay(PAUSE_TIME);
+			}
+
+			Uint32 lResume = SDL_GetTicks();
+			paused_time += lResume - lPauseStart;
+			lNextTick = lResume + TICK_TIME;
+			continue;
+		}
+
+		Uint32 lNow = SDL_GetTicks();
+		if(lNow < lNextTick)
+		{
+			SDL_Delay(lNextTick - lNow);
+		}
+		lNextTick += TICK_TIME;
+
+		if(tick() != Level::PLAYING)
+		{
+			break;
+		}
+	}
+}
+
+/**
+ * tick
+ * \brief Apply the forwarded inputs, update the level and publish its commands
+ * \return int : level state (Level::PLAYING, FINISHED, FAILED or TIME_OUT)
+ **/
+int SimThread::tick()
+{
+	SDL_Event lEvent;
+	while(inputs.pop(lEvent))
+	{
+		level->on_event(&lEvent);
+	}
+
+	FrameSnapshot& lSnapshot = snapshots.write_buffer();
+	lSnapshot.clear();
+	lSnapshot.time = SDL_GetTicks() - paused_time;
+	lSnapshot.state = level->update(lSnapshot.time);
+
+	level->set_renderer(&lSnapshot);
+	level->render(nullptr);
+
+	//Background and ground sent again only to the buffers holding another static layer
+	if(level->get_static_stamp() != level_static_stamp)
+	{
+		level_static_stamp = level->get_static_stamp();
+		static_stamp++;
+	}
+	if(lSnapshot.get_static_stamp() != static_stamp)
+	{
+		lSnapshot.begin_static(static_stamp);
+		level->render_tiles();
+		lSnapshot.end_static();
+	}
+
+	snapshots.publish();
+
+	return lSnapshot.state;
+}
+
+/**
+ * post_event
+ * \param pEvent : Input event
+ * \brief Forward an input to the next simulation tick
+ * \return boolean : post status (false if the input queue is full)
+ **/
+bool SimThread::post_event(const SDL_Event& pEvent)
+{
+	return inputs.push(pEvent);
+}
+
+/**
+ * get_snapshot
+ * \brief Take the latest snapshot published by the simulation
+ * \return const FrameSnapshot& : snapshot (valid until the next call)
+ **/
+const FrameSnapshot& SimThread::get_snapshot()
+{
+	snapshots.update();
+	return snapshots.read_buffer();
+}
@@ -0,0 +1,96 @@
+#ifndef SIM_THREAD_H
+#define SIM_THREAD_H
+
+#include <atomic>
+#include <thread>
+#include <SDL2/SDL.h>
+#include "level.h"
+#include "frame_snapshot.h"
+#include "triple_buffer.h"
+#include "spsc_queue.h"
+
+/**
+ * \class SimThread
+ * \brief Level simulation on its own thread: every tick applies the forwarded
+ *        inputs, updates the level and publishes its render commands as a
+ *        snapshot (the render thread draws the latest one, a slow present
+ *        does not delay the moves and the collisions anymore)
+ *
+ * The thread stops by itself after the tick leaving the PLAYING state. The
+ * level must not be used by another thread while the simulation runs.
+ * The static layer of the snapshots is only recorded when it changes.
+ * Paused (window in the background), the thread only polls the pause flag
+ * and the paused time is taken off the game time.
+ **/
+class SimThread
+{
+	private:
+		//Simulation tick (ms)
+		static const Uint32 TICK_TIME = 4;
+
+		//Inputs waiting for the next tick
+		static const size_t INPUT_QUEUE_SIZE = 256;
+
+		//Pause flag polling (ms)
+		static const Uint32 PAUSE_TIME = 20;
+
+		Level* level;
+		std::thread thread;
+		std::atomic<bool> is_stopping;
+		std::atomic<bool> is_paused;
+
+		//Time spent paused, taken off the game time (ms)
+		Uint32 paused_time;
+
+		//Last static layer stamp of the level, stamp given to the snapshots
+		//(changed with it and with every level)
+		Uint32 level_static_stamp;
+		Uint32 static_stamp;
+
+		SpscQueue<SDL_Event, INPUT_QUEUE_SIZE> inputs;
+		TripleBuffer<FrameSnapshot> snapshots;
+
+		//Thread loop
+		void run();
+
+		//Simulate and publish one tick
+		int tick();
+
+	public:
+		//Constructor
+		SimThread()
+		{
+			level = nullptr;
+			is_stopping = false;
+			is_paused = false;
+			paused_time = 0;
+			level_static_stamp = 0;
+			static_stamp = 0;
+		}
+
+		//Destructor
+		~SimThread()
+		{
+			stop();
+		}
+
+		//Simulate the level on the thread (the first tick is published before returning)
+		void start(Level* pLevel);
+
+		//Stop and join the thread
+		void stop();
+
+		//Pause or resume the simulation (kept across levels)
+		void set_paused(bool pIsPaused){is_paused = pIsPaused;}
+
+		//Getter for the running status
+		bool is_running(){return thread.joinable();}
+
+		//Forward an input to the simulation
+		bool post_event(const SDL_Event& pEvent);
+
+		//Getter for the latest published snapshot (render thread)
+		const FrameSnapshot& get_snapshot();
+};
+
+#endif
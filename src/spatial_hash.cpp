@@ -0,0 +1,120 @@
+#include "spatial_hash.h"
+
+/**
+ * cells_of
+ * \param pRect : Area (pixels)
+ * \brief Give the cells covered by an area
+ * \return SDL_Rect : first cell (x, y) and cell count (w, h)
+ **/
+SDL_Rect SpatialHash::cells_of(const SDL_Rect& pRect)
+{
+	int lX = cell_of(pRect.x);
+	int lY = cell_of(pRect.y);
+	return {lX, lY, cell_of(pRect.x + pRect.w - 1) - lX + 1, cell_of(pRect.y + pRect.h - 1) - lY + 1};
+}
+
+/**
+ * insert
+ * \param pRect : Entity rect (pixels)
+ * \param pChunk : Chunk key of the entity
+ * \param pIndex : Entity index in the chunk store
+ * \brief List an entity in every cell its rect covers
+ * \return void
+ **/
+void SpatialHash::insert(const SDL_Rect& pRect, Uint64 pChunk, Uint32 pIndex)
+{
+	SDL_Rect lCells = cells_of(pRect);
+	for(int lY = lCells.y; lY < lCells.y + lCells.h; lY++)
+	{
+		for(int lX = lCells.x; lX < lCells.x + lCells.w; lX++)
+		{
+			cells[make_key(lX, lY)].push_back({pChunk, pIndex});
+		}
+	}
+}
+
+/**
+ * remove
+ * \param pRect : Entity rect when it was listed (pixels)
+ * \param pChunk : Chunk key of the entity
+ * \param pIndex : Entity index in the chunk store
+ * \brief Remove an entity from the cells of its rect (empty cells are dropped)
+ * \return void
+ **/
+void SpatialHash::remove(const SDL_Rect& pRect, Uint64 pChunk, Uint32 pIndex)
+{
+	SDL_Rect lCells = cells_of(pRect);
+	for(int lY = lCells.y; lY < lCells.y + lCells.h; lY++)
+	{
+		for(int lX = lCells.x; lX < lCells.x + lCells.w; lX++)
+		{
+			auto lCell = cells.find(make_key(lX, lY));
+			if(lCell == cells.end())
+			{
+				continue;
+			}
+
+			std::vector<Entry>& lEntries = lCell->second;
+			for(size_t lIdx = 0; lIdx < lEntries.size(); lIdx++)
+			{
+				if(lEntries[lIdx].chunk == pChunk && lEntries[lIdx].index == pIndex)
+				{
+					lEntries[lIdx] = lEntries.back();
+					lEntries.pop_back();
+					break;
+				}
+			}
+
+			if(lEntries.empty())
+			{
+				cells.erase(lCell);
+			}
+		}
+	}
+}
+
+/**
+ * move
+ * \param pFrom : Entity rect when it was listed (pixels)
+ * \param pTo : New entity rect (pixels)
+ * \param pChunk : Chunk key of the entity
+ * \param pIndex : Entity index in the chunk store
+ * \brief Move an entity to the cells of its new rect (nothing to do while
+ *        it stays in the same cells)
+ * \return void
+ **/
+void SpatialHash::move(const SDL_Rect& pFrom, const SDL_Rect& pTo, Uint64 pChunk, Uint32 pIndex)
+{
+	SDL_Rect lFrom = cells_of(pFrom);
+	SDL_Rect lTo = cells_of(pTo);
+	if(SDL_RectEquals(&lFrom, &lTo))
+	{
+		return;
+	}
+
+	remove(pFrom, pChunk, pIndex);
+	insert(pTo, pChunk, pIndex);
+}
+
+/**
+ * query
+ * \param pRect : Area (pixels)
+ * \param pFound : Entities listed in the cells of the area (output, added at the end)
+ * \brief Give the entities that may intersect an area (their rects are to be tested)
+ * \return void
+ **/
+void SpatialHash::query(const SDL_Rect& pRect, std::vector<Entry>& pFound) const
+{
+	SDL_Rect lCells = cells_of(pRect);
+	for(int lY = lCells.y; lY < lCells.y + lCells.h; lY++)
+	{
+		for(int lX = lCells.x; lX < lCells.x + lCells.w; lX++)
+		{
+			auto lCell = cells.find(make_key(lX, lY));
+			if(lCell != cells.end())
+			{
+				pFound.insert(pFound.end(), lCell->second.begin(), lCell->second.end());
+			}
+		}
+	}
+}
@@ -0,0 +1,58 @@
+#ifndef SPATIAL_HASH_H
+#define SPATIAL_HASH_H
+
+#include <vector>
+#include <unordered_map>
+#include <SDL2/SDL.h>
+
+/**
+ * \class SpatialHash
+ * \brief Uniform grid of the level entities hashed by cell: an entity is
+ *        listed in every cell its rect covers, a query only visits the
+ *        cells of its area (the cost does not grow with the entity count)
+ *
+ * Entities are referenced by chunk key and index in the chunk store: the
+ * store updates its entries when an entity moves or changes index.
+ **/
+class SpatialHash
+{
+	public:
+		//Cell size (pixels, two tiles)
+		static const int CELL_SIZE = 128;
+
+		struct Entry
+		{
+			Uint64 chunk;
+			Uint32 index;
+		};
+
+	private:
+		std::unordered_map<Uint64, std::vector<Entry>> cells;
+
+		//Cell of a map coordinate (pixels)
+		static int cell_of(int pPixel){return (pPixel >= 0) ? pPixel / CELL_SIZE : (pPixel - CELL_SIZE + 1) / CELL_SIZE;}
+
+		//Key of a cell
+		static Uint64 make_key(int pX, int pY){return ((Uint64)(Uint32)pY << 32) | (Uint32)pX;}
+
+		//Cells covered by a rect
+		static SDL_Rect cells_of(const SDL_Rect& pRect);
+
+	public:
+		//List an entity in the cells of its rect
+		void insert(const SDL_Rect& pRect, Uint64 pChunk, Uint32 pIndex);
+
+		//Remove an entity from the cells of its rect
+		void remove(const SDL_Rect& pRect, Uint64 pChunk, Uint32 pIndex);
+
+		//Move an entity (only when it changes cells)
+		void move(const SDL_Rect& pFrom, const SDL_Rect& pTo, Uint64 pChunk, Uint32 pIndex);
+
+		//Add the entities listed in the cells of an area (an entity may be given more than once)
+		void query(const SDL_Rect& pRect, std::vector<Entry>& pFound) const;
+
+		//Remove every entity
+		void clear(){cells.clear();}
+};
+
+#endif
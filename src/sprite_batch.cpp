@@ -0,0 +1,143 @@
+#include "sprite_batch.h"
+
+/**
+ * begin
+ * \brief Drop the sprites not flushed yet (e.g. a frame interrupted by a failure)
+ * \return void
+ **/
+void SpriteBatch::begin()
+{
+	sprites.clear();
+	runs.clear();
+}
+
+/**
+ * add
+ * \param pTexture : Sprite texture
+ * \param pSrc : Area of the texture
+ * \param pDst : Area of the screen
+ * \param pIsFlipped : Mirror the sprite horizontally
+ * \param pColor : Tint (white to keep the texture colors)
+ * \brief Add a sprite, following the previous one in the same run if it shares its texture
+ * \return void
+ **/
+void SpriteBatch::add(SDL_Texture* pTexture, const SDL_Rect& pSrc, const SDL_Rect& pDst, bool pIsFlipped, SDL_Color pColor)
+{
+	if(pTexture == nullptr)
+	{
+		return;
+	}
+
+	if(runs.empty() || runs.back().texture != pTexture)
+	{
+		runs.push_back({pTexture, (int)sprites.size(), 0});
+	}
+	runs.back().count++;
+
+	sprites.push_back({pSrc, pDst, pColor, pIsFlipped});
+}
+
+/**
+ * flush
+ * \param pRenderer : Game renderer
+ * \brief Draw the collected sprites, one draw call per run of sprites sharing a texture
+ * \return void
+ **/
+void SpriteBatch::flush(SDL_Renderer* pRenderer)
+{
+	draw_calls = 0;
+	sprite_count = sprites.size();
+
+	for(auto &lRun : runs)
+	{
+		if(submit_geometry(pRenderer, lRun))
+		{
+			draw_calls++;
+		}
+		else
+		{
+			submit_copies(pRenderer, lRun);
+			draw_calls += lRun.count;
+		}
+	}
+
+	begin();
+}
+
+/**
+ * submit_geometry
+ * \param pRenderer : Game renderer
+ * \param pRun : Sprites sharing a texture
+ * \brief Build the quads of a run and submit them with SDL_RenderGeometry
+ * \return boolean : submit status (false if the geometry cannot be drawn)
+ **/
+bool SpriteBatch::submit_geometry(SDL_Renderer* pRenderer, const Run& pRun)
+{
+	int lWidth{0};
+	int lHeight{0};
+	if(SDL_QueryTexture(pRun.texture, nullptr, nullptr, &lWidth, &lHeight) < 0 || lWidth <= 0 || lHeight <= 0)
+	{
+		return false;
+	}
+
+	//Quad corners: top left, top right, bottom left, bottom right
+	for(int lIdx = (int)indices.size() / 6; lIdx < pRun.count; lIdx++)
+	{
+		int lFirst = lIdx * 4;
+		indices.insert(indices.end(), {lFirst, lFirst + 1, lFirst + 2, lFirst + 2, lFirst + 1, lFirst + 3});
+	}
+
+	vertices.resize(pRun.count * 4);
+	SDL_Vertex* lVertex = vertices.data();
+	for(int lIdx = pRun.first; lIdx < pRun.first + pRun.count; lIdx++)
+	{
+		const Sprite& lSprite = sprites[lIdx];
+
+		float lLeft = (float)lSprite.dst.x;
+		float lTop = (float)lSprite.dst.y;
+		float lRight = (float)(lSprite.dst.x + lSprite.dst.w);
+		float lBottom = (float)(lSprite.dst.y + lSprite.dst.h);
+
+		float lU1 = (float)lSprite.src.x / lWidth;
+		float lV1 = (float)lSprite.src.y / lHeight;
+		float lU2 = (float)(lSprite.src.x + lSprite.src.w) / lWidth;
+		float lV2 = (float)(lSprite.src.y + lSprite.src.h) / lHeight;
+
+		//Mirrored: left and right UVs swapped (instead of SDL_RenderCopyEx)
+		if(lSprite.is_flipped)
+		{
+			float lSwap = lU1;
+			lU1 = lU2;
+			lU2 = lSwap;
+		}
+
+		*lVertex++ = {{lLeft, lTop}, lSprite.color, {lU1, lV1}};
+		*lVertex++ = {{lRight, lTop}, lSprite.color, {lU2, lV1}};
+		*lVertex++ = {{lLeft, lBottom}, lSprite.color, {lU1, lV2}};
+		*lVertex++ = {{lRight, lBottom}, lSprite.color, {lU2, lV2}};
+	}
+
+	return SDL_RenderGeometry(pRenderer, pRun.texture, vertices.data(), pRun.count * 4, indices.data(), pRun.count * 6) == 0;
+}
+
+/**
+ * submit_copies
+ * \param pRenderer : Game renderer
+ * \param pRun : Sprites sharing a texture
+ * \brief Draw a run of sprites one by one (the geometry call failed)
+ * \return void
+ **/
+void SpriteBatch::submit_copies(SDL_Renderer* pRenderer, const Run& pRun)
+{
+	Uint8 lRed, lGreen, lBlue;
+	SDL_GetTextureColorMod(pRun.texture, &lRed, &lGreen, &lBlue);
+
+	for(int lIdx = pRun.first; lIdx < pRun.first + pRun.count; lIdx++)
+	{
+		const Sprite& lSprite = sprites[lIdx];
+		SDL_SetTextureColorMod(pRun.texture, lSprite.color.r, lSprite.color.g, lSprite.color.b);
+		SDL_RenderCopyEx(pRenderer, pRun.texture, &lSprite.src, &lSprite.dst, 0, nullptr, lSprite.is_flipped ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE);
+	}
+
+	SDL_SetTextureColorMod(pRun.texture, lRed, lGreen, lBlue);
+}
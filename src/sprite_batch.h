@@ -0,0 +1,75 @@
+#ifndef SPRITE_BATCH_H
+#define SPRITE_BATCH_H
+
+#include <vector>
+#include <SDL2/SDL.h>
+
+/**
+ * \class SpriteBatch
+ * \brief Sprites of a frame collected as quads and submitted with one
+ *        SDL_RenderGeometry call per run of sprites sharing a texture
+ *        (drawing order is kept, mirrored sprites swap their UVs)
+ *
+ * Needs SDL 2.0.18. If the geometry call fails (e.g. a texture that cannot
+ * be queried), the sprites of the run are drawn one by one with SDL_RenderCopyEx.
+ **/
+class SpriteBatch
+{
+	private:
+		struct Sprite
+		{
+			SDL_Rect src;
+			SDL_Rect dst;
+			SDL_Color color;
+			bool is_flipped;
+		};
+
+		struct Run
+		{
+			SDL_Texture* texture;
+			int first;
+			int count;
+		};
+
+		std::vector<Sprite> sprites;
+		std::vector<Run> runs;
+
+		//Vertex buffers, 4 vertices and 6 indices per quad (indices shared by every run)
+		std::vector<SDL_Vertex> vertices;
+		std::vector<int> indices;
+
+		//Draw calls and sprites of the last flush
+		int draw_calls;
+		int sprite_count;
+
+		//Submit a run of sprites with SDL_RenderGeometry
+		bool submit_geometry(SDL_Renderer* pRenderer, const Run& pRun);
+
+		//Draw a run of sprites one by one
+		void submit_copies(SDL_Renderer* pRenderer, const Run& pRun);
+
+	public:
+		//Constructor
+		SpriteBatch()
+		{
+			draw_calls = 0;
+			sprite_count = 0;
+		}
+
+		//Drop the sprites not flushed yet
+		void begin();
+
+		//Add a sprite (mirrored horizontally if flipped, tinted by the color)
+		void add(SDL_Texture* pTexture, const SDL_Rect& pSrc, const SDL_Rect& pDst, bool pIsFlipped=false, SDL_Color pColor={255, 255, 255, 255});
+
+		//Draw the collected sprites
+		void flush(SDL_Renderer* pRenderer);
+
+		//Getter for the draw calls of the last flush
+		int get_draw_calls(){return draw_calls;}
+
+		//Getter for the sprites of the last flush
+		int get_sprite_count(){return sprite_count;}
+};
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef SPRITE_SHEET_H
+#define SPRITE_SHEET_H
+
+#include <SDL2/SDL.h>
+
+/**
+ * \struct SpriteSheet
+ * \brief Shared sprite sheet handle (texture + area of the sheet in it)
+ **/
+struct SpriteSheet
+{
+	SDL_Texture* texture;
+	SDL_Rect rect;
+
+	//Constructor
+	SpriteSheet(SDL_Texture* pTexture=nullptr)
+	{
+		texture = pTexture;
+		rect.x = 0;
+		rect.y = 0;
+		rect.w = 0;
+		rect.h = 0;
+	}
+
+	//Translate a frame of the sheet into the texture
+	SDL_Rect frame(SDL_Rect pFrame) const
+	{
+		pFrame.x += rect.x;
+		pFrame.y += rect.y;
+		return pFrame;
+	}
+};
+
+#endif
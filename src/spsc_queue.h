@@ -0,0 +1,64 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+
+/**
+ * \class SpscQueue
+ * \brief Lock-free ring of N items (power of two) between one producer
+ *        thread and one consumer thread
+ *
+ * The indices only grow: the ring is full when they are N items apart.
+ **/
+template<class T, size_t N>
+class SpscQueue
+{
+	private:
+		static_assert(N > 0 && (N & (N - 1)) == 0, "SpscQueue size must be a power of two");
+
+		T items[N];
+
+		//Next item to pop (consumer), next item to push (producer)
+		std::atomic<size_t> head{0};
+		std::atomic<size_t> tail{0};
+
+	public:
+		/**
+		 * push (producer thread)
+		 * \param pItem : Item to add
+		 * \brief Add an item at the end of the ring
+		 * \return boolean : push status (false if the ring is full)
+		 **/
+		bool push(const T& pItem)
+		{
+			size_t lTail = tail.load(std::memory_order_relaxed);
+			if(lTail - head.load(std::memory_order_acquire) == N)
+			{
+				return false;
+			}
+			items[lTail & (N - 1)] = pItem;
+			tail.store(lTail + 1, std::memory_order_release);
+			return true;
+		}
+
+		/**
+		 * pop (consumer thread)
+		 * \param pItem : Oldest item (output)
+		 * \brief Take the oldest item of the ring
+		 * \return boolean : pop status (false if the ring is empty)
+		 **/
+		bool pop(T& pItem)
+		{
+			size_t lHead = head.load(std::memory_order_relaxed);
+			if(lHead == tail.load(std::memory_order_acquire))
+			{
+				return false;
+			}
+			pItem = items[lHead & (N - 1)];
+			head.store(lHead + 1, std::memory_order_release);
+			return true;
+		}
+};
+
+#endif
@@ -0,0 +1,205 @@
+#include "text_renderer.h"
+#include <iostream>
+
+/**
+ * load
+ * \param pRenderer : Game renderer
+ * \param pVfs : Game files
+ * \param pFontId : Font file
+ * \param pSize : Font size
+ * \brief Rasterize the printable ASCII glyphs of a font into one atlas texture
+ * \return boolean : load status
+ **/
+bool TextRenderer::load(SDL_Renderer* pRenderer, Vfs* pVfs, AssetId pFontId, int pSize)
+{
+	dispose();
+
+	TTF_Font* lFont = TTF_OpenFontRW(pVfs->open(pFontId), 1, pSize);
+	if(lFont == nullptr)
+	{
+		std::cerr << "Cannot load the font" << std::endl;
+		return false;
+	}
+	line_height = TTF_FontLineSkip(lFont);
+
+	//Render every glyph in white (colored when drawn), shelf packed
+	SDL_Color lWhite = {255, 255, 255, 255};
+	SDL_Surface* lImages[GLYPH_COUNT];
+	int lX{0};
+	int lY{0};
+	int lShelfHeight{0};
+	for(int lIdx = 0; lIdx < GLYPH_COUNT; lIdx++)
+	{
+		Uint16 lChar = FIRST_GLYPH + lIdx;
+		Glyph& lGlyph = glyphs[lIdx];
+
+		int lMinX{0};
+		lGlyph.advance = 0;
+		TTF_GlyphMetrics(lFont, lChar, &lMinX, nullptr, nullptr, nullptr, &lGlyph.advance);
+		lGlyph.offset_x = (lMinX < 0) ? lMinX : 0;
+
+		//Rendered as a one character text: same height and baseline for every glyph
+		char lText[2] = {(char)lChar, '\0'};
+		lImages[lIdx] = TTF_RenderText_Blended(lFont, lText, lWhite);
+		if(lImages[lIdx] == nullptr)
+		{
+			lGlyph.rect = {0, 0, 0, 0};
+			continue;
+		}
+
+		if(lX + lImages[lIdx]->w > ATLAS_WIDTH)
+		{
+			lX = 0;
+			lY += lShelfHeight + 1;
+			lShelfHeight = 0;
+		}
+		lGlyph.rect = {lX, lY, lImages[lIdx]->w, lImages[lIdx]->h};
+		lX += lImages[lIdx]->w + 1;
+		if(lImages[lIdx]->h > lShelfHeight)
+		{
+			lShelfHeight = lImages[lIdx]->h;
+		}
+	}
+	TTF_CloseFont(lFont);
+
+	SDL_Surface* lAtlas = SDL_CreateRGBSurfaceWithFormat(0, ATLAS_WIDTH, lY + lShelfHeight, 32, SDL_PIXELFORMAT_ARGB8888);
+	if(lAtlas != nullptr)
+	{
+		SDL_FillRect(lAtlas, nullptr, 0);
+	}
+
+	for(int lIdx = 0; lIdx < GLYPH_COUNT; lIdx++)
+	{
+		if(lImages[lIdx] == nullptr)
+		{
+			continue;
+		}
+
+		if(lAtlas != nullptr)
+		{
+			//Copy the alpha channel too
+			SDL_SetSurfaceBlendMode(lImages[lIdx], SDL_BLENDMODE_NONE);
+			SDL_BlitSurface(lImages[lIdx], nullptr, lAtlas, &glyphs[lIdx].rect);
+		}
+		SDL_FreeSurface(lImages[lIdx]);
+	}
+
+	if(lAtlas == nullptr)
+	{
+		std::cerr << "Cannot create the glyph atlas" << std::endl;
+		return false;
+	}
+
+	atlas_texture = SDL_CreateTextureFromSurface(pRenderer, lAtlas);
+	SDL_FreeSurface(lAtlas);
+	if(atlas_texture == nullptr)
+	{
+		std::cerr << "Cannot create the glyph atlas texture" << std::endl;
+		return false;
+	}
+	SDL_SetTextureBlendMode(atlas_texture, SDL_BLENDMODE_BLEND);
+
+	return true;
+}
+
+/**
+ * get_glyph
+ * \param pChar : Character
+ * \brief Getter for the glyph of a character
+ * \return const Glyph* : glyph (nullptr if not in the atlas)
+ **/
+const TextRenderer::Glyph* TextRenderer::get_glyph(char pChar)
+{
+	if(pChar < FIRST_GLYPH || pChar > LAST_GLYPH)
+	{
+		return nullptr;
+	}
+	return &glyphs[pChar - FIRST_GLYPH];
+}
+
+/**
+ * get_word_width
+ * \param pText : Text, at the start of a word
+ * \brief Width of a word (until a space, a line break or the end of the text)
+ * \return int : word width (pixels)
+ **/
+int TextRenderer::get_word_width(const char* pText)
+{
+	int lWidth{0};
+	for(; *pText != '\0' && *pText != ' ' && *pText != '\n'; pText++)
+	{
+		const Glyph* lGlyph = get_glyph(*pText);
+		if(lGlyph != nullptr)
+		{
+			lWidth += lGlyph->advance;
+		}
+	}
+	return lWidth;
+}
+
+/**
+ * draw
+ * \param pRenderer : Frame renderer
+ * \param pText : Text
+ * \param pX : Position X (pixels)
+ * \param pY : Position Y (pixels)
+ * \param pColor : Text color
+ * \param pWrapWidth : Wrap width (pixels, 0 to only break lines on '\n')
+ * \brief Add the glyph quads of a text to the HUD layer (every quad uses
+ *        the atlas texture, so the text is one run of the batch)
+ * \return void
+ **/
+void TextRenderer::draw(GameRenderer* pRenderer, const char* pText, int pX, int pY, SDL_Color pColor, int pWrapWidth)
+{
+	if(atlas_texture == nullptr)
+	{
+		return;
+	}
+
+	int lPenX = pX;
+	int lPenY = pY;
+	for(const char* lChar = pText; *lChar != '\0'; lChar++)
+	{
+		if(*lChar == '\n')
+		{
+			lPenX = pX;
+			lPenY += line_height;
+			continue;
+		}
+
+		//Wrap before a word that does not fit
+		if(pWrapWidth > 0 && lPenX > pX && (lChar == pText || *(lChar - 1) == ' ') &&
+			lPenX + get_word_width(lChar) > pX + pWrapWidth)
+		{
+			lPenX = pX;
+			lPenY += line_height;
+		}
+
+		const Glyph* lGlyph = get_glyph(*lChar);
+		if(lGlyph == nullptr)
+		{
+			continue;
+		}
+
+		if(*lChar != ' ' && lGlyph->rect.w > 0)
+		{
+			SDL_Rect lDst = {lPenX + lGlyph->offset_x, lPenY, lGlyph->rect.w, lGlyph->rect.h};
+			pRenderer->push(GameRenderer::LAYER_HUD, atlas_texture, lGlyph->rect, lDst, false, pColor);
+		}
+		lPenX += lGlyph->advance;
+	}
+}
+
+/**
+ * dispose
+ * \brief Destroy the glyph atlas
+ * \return void
+ **/
+void TextRenderer::dispose()
+{
+	if(atlas_texture != nullptr)
+	{
+		SDL_DestroyTexture(atlas_texture);
+		atlas_texture = nullptr;
+	}
+}
@@ -0,0 +1,62 @@
+#ifndef TEXT_RENDERER_H
+#define TEXT_RENDERER_H
+
+#include <SDL2/SDL.h>
+#include "vfs.h"
+#include "game_renderer.h"
+
+#ifdef __APPLE__
+#include <SDL2_ttf/SDL_ttf.h>
+#else
+#include <SDL2/SDL_ttf.h>
+#endif
+
+/**
+ * \class TextRenderer
+ * \brief Text drawn from a glyph atlas (printable ASCII glyphs of the font
+ *        rasterized once into one texture, strings drawn glyph by glyph)
+ **/
+class TextRenderer
+{
+	private:
+		static const int FIRST_GLYPH = 32;
+		static const int LAST_GLYPH = 126;
+		static const int GLYPH_COUNT = LAST_GLYPH - FIRST_GLYPH + 1;
+		static const int ATLAS_WIDTH = 512;
+
+		struct Glyph
+		{
+			SDL_Rect rect;
+			int offset_x;
+			int advance;
+		};
+
+		SDL_Texture* atlas_texture;
+		Glyph glyphs[GLYPH_COUNT];
+		int line_height;
+
+		//Getter for the glyph of a character (nullptr if not in the atlas)
+		const Glyph* get_glyph(char pChar);
+
+		//Width of a word (until a space or the end of the text)
+		int get_word_width(const char* pText);
+
+	public:
+		//Constructor
+		TextRenderer()
+		{
+			atlas_texture = nullptr;
+			line_height = 0;
+		}
+
+		//Rasterize the glyphs of a font into the atlas
+		bool load(SDL_Renderer* pRenderer, Vfs* pVfs, AssetId pFontId, int pSize);
+
+		//Add a text to the HUD layer ('\n' breaks lines, words are wrapped when a wrap width is given)
+		void draw(GameRenderer* pRenderer, const char* pText, int pX, int pY, SDL_Color pColor, int pWrapWidth=0);
+
+		//Destroy the atlas
+		void dispose();
+};
+
+#endif
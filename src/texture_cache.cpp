@@ -0,0 +1,238 @@
+#include "texture_cache.h"
+#include <iostream>
+#include <sstream>
+
+/**
+ * load_atlas
+ * \param pIndexId : Atlas manifest
+ * \param pImageId : Atlas image
+ * \param pSheetPath : Directory of the packed sheets (e.g. assets/)
+ * \brief Load the atlas manifest (lines of "name x y w h")
+ * \return boolean : load atlas status
+ **/
+bool TextureCache::load_atlas(AssetId pIndexId, AssetId pImageId, std::string pSheetPath)
+{
+	std::string index_content;
+	if(!vfs->read(pIndexId, index_content))
+	{
+		return false;
+	}
+
+	std::istringstream index_file(index_content);
+	std::string line;
+	while(getline(index_file, line))
+	{
+		if(line.empty() || line[0] == '#')
+		{
+			continue;
+		}
+
+		std::istringstream lStream(line);
+		std::string lName;
+		SDL_Rect lRect;
+		if(lStream >> lName >> lRect.x >> lRect.y >> lRect.w >> lRect.h)
+		{
+			atlas_rects[vfs->intern(pSheetPath + lName + ".png")] = lRect;
+		}
+	}
+
+	atlas_id = pImageId;
+	return !atlas_rects.empty();
+}
+
+/**
+ * get_key
+ * \param pId : Image
+ * \brief Cache key of an image (the atlas image if the sheet is packed)
+ * \return AssetId : cache key
+ **/
+AssetId TextureCache::get_key(AssetId pId)
+{
+	if(atlas_rects.count(pId) > 0)
+	{
+		return atlas_id;
+	}
+	return pId;
+}
+
+/**
+ * acquire
+ * \param pId : Image
+ * \brief Take a reference on the image (decoded by the next decode call)
+ * \return void
+ **/
+void TextureCache::acquire(AssetId pId)
+{
+	pId = get_key(pId);
+
+	auto lIt = entries.find(pId);
+	if(lIt != entries.end())
+	{
+		lIt->second.ref_count++;
+		return;
+	}
+
+	Entry lEntry;
+	lEntry.image = nullptr;
+	lEntry.texture = nullptr;
+	lEntry.ref_count = 1;
+	entries[pId] = lEntry;
+}
+
+/**
+ * decode
+ * \brief Decode every acquired image concurrently on the decode pool
+ * \return boolean : decode status (false if an image cannot be loaded)
+ **/
+bool TextureCache::decode()
+{
+	std::vector<AssetId> lIds;
+	for(auto &lEntry : entries)
+	{
+		if(lEntry.second.image == nullptr && lEntry.second.texture == nullptr)
+		{
+			lIds.push_back(lEntry.first);
+		}
+	}
+
+	std::vector<SDL_Surface*> lImages;
+	pool->decode(lIds, lImages);
+
+	bool lStatus = true;
+	for(size_t lIdx = 0; lIdx < lIds.size(); lIdx++)
+	{
+		entries[lIds[lIdx]].image = lImages[lIdx];
+		if(lImages[lIdx] == nullptr)
+		{
+			lStatus = false;
+		}
+	}
+	return lStatus;
+}
+
+/**
+ * release
+ * \param pId : Image
+ * \brief Drop a reference, free the image when nobody uses it anymore
+ *        (kept until clear when deferred)
+ * \return void
+ **/
+void TextureCache::release(AssetId pId)
+{
+	auto lIt = entries.find(get_key(pId));
+	if(lIt == entries.end())
+	{
+		return;
+	}
+
+	lIt->second.ref_count--;
+	if(lIt->second.ref_count <= 0)
+	{
+		if(is_deferred)
+		{
+			released.push_back(lIt->second);
+		}
+		else
+		{
+			dispose(lIt->second);
+		}
+		entries.erase(lIt);
+	}
+}
+
+/**
+ * init_textures
+ * \param pRenderer : Game renderer
+ * \brief Create the texture of every decoded image
+ * \return boolean : init textures status
+ **/
+bool TextureCache::init_textures(SDL_Renderer* pRenderer)
+{
+	for(auto &lEntry : entries)
+	{
+		if(lEntry.second.texture != nullptr)
+		{
+			continue;
+		}
+
+		lEntry.second.texture = PixelCache::create_texture(pRenderer, lEntry.second.image);
+		if(lEntry.second.texture == nullptr)
+		{
+			std::cerr << "Invalid texture: " + vfs->get_name(lEntry.first) << std::endl;
+			return false;
+		}
+		SDL_FreeSurface(lEntry.second.image);
+		lEntry.second.image = nullptr;
+	}
+	return true;
+}
+
+/**
+ * get_sheet
+ * \param pId : Image
+ * \brief Getter for the shared sprite sheet of an image
+ * \return SpriteSheet : sheet (nullptr texture if not initialized)
+ **/
+SpriteSheet TextureCache::get_sheet(AssetId pId)
+{
+	AssetId lKey = get_key(pId);
+
+	auto lIt = entries.find(lKey);
+	if(lIt == entries.end())
+	{
+		return SpriteSheet();
+	}
+
+	SpriteSheet lSheet(lIt->second.texture);
+	if(lKey == atlas_id)
+	{
+		lSheet.rect = atlas_rects[pId];
+	}
+	else
+	{
+		SDL_QueryTexture(lSheet.texture, nullptr, nullptr, &lSheet.rect.w, &lSheet.rect.h);
+	}
+	return lSheet;
+}
+
+/**
+ * clear
+ * \brief Free every image and texture of the cache
+ * \return void
+ **/
+void TextureCache::clear()
+{
+	for(auto &lEntry : entries)
+	{
+		dispose(lEntry.second);
+	}
+	entries.clear();
+
+	for(auto &lEntry : released)
+	{
+		dispose(lEntry);
+	}
+	released.clear();
+	is_deferred = false;
+}
+
+/**
+ * dispose
+ * \param pEntry : Cache entry
+ * \brief Destroy the surface and the texture of an entry
+ * \return void
+ **/
+void TextureCache::dispose(Entry& pEntry)
+{
+	if(pEntry.image != nullptr)
+	{
+		SDL_FreeSurface(pEntry.image);
+		pEntry.image = nullptr;
+	}
+
+	if(pEntry.texture != nullptr)
+	{
+		SDL_DestroyTexture(pEntry.texture);
+		pEntry.texture = nullptr;
+	}
+}
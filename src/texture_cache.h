@@ -0,0 +1,86 @@
+#ifndef TEXTURE_CACHE_H
+#define TEXTURE_CACHE_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <SDL2/SDL.h>
+#include "sprite_sheet.h"
+#include "vfs.h"
+#include "decode_pool.h"
+
+#ifdef __APPLE__
+#include <SDL2_image/SDL_image.h>
+#else
+#include <SDL2/SDL_image.h>
+#endif
+
+/**
+ * \class TextureCache
+ * \brief Shared sprite sheets (one decode and one texture per image,
+ *        sheets packed in the atlas resolve into the atlas texture)
+ **/
+class TextureCache
+{
+	private:
+		struct Entry
+		{
+			SDL_Surface* image;
+			SDL_Texture* texture;
+			int ref_count;
+		};
+
+		Vfs* vfs;
+		DecodePool* pool;
+		std::unordered_map<AssetId, Entry> entries;
+
+		//Entries released while deferred (freed by clear)
+		std::vector<Entry> released;
+		bool is_deferred;
+
+		//Atlas image and area of every packed sheet
+		AssetId atlas_id;
+		std::unordered_map<AssetId, SDL_Rect> atlas_rects;
+
+		//Cache key of an image (the atlas if the sheet is packed)
+		AssetId get_key(AssetId pId);
+
+		//Destroy the surface and the texture of an entry
+		void dispose(Entry& pEntry);
+
+	public:
+		//Constructor
+		TextureCache(Vfs* pVfs=nullptr, DecodePool* pPool=nullptr)
+		{
+			vfs = pVfs;
+			pool = pPool;
+			atlas_id = Vfs::INVALID_ASSET;
+			is_deferred = false;
+		}
+
+		//Load the atlas manifest (sheets of the given directory are then resolved into the atlas)
+		bool load_atlas(AssetId pIndexId, AssetId pImageId, std::string pSheetPath);
+
+		//Take a reference on the image (decoded by the next decode call)
+		void acquire(AssetId pId);
+
+		//Drop a reference (freed when the image is not used anymore)
+		void release(AssetId pId);
+
+		//Keep the images released from now on until clear
+		void set_deferred(bool pIsDeferred){is_deferred = pIsDeferred;}
+
+		//Decode every acquired image on the decode pool
+		bool decode();
+
+		//Create the textures of every decoded image
+		bool init_textures(SDL_Renderer* pRenderer);
+
+		//Getter for the shared sprite sheet of an image
+		SpriteSheet get_sheet(AssetId pId);
+
+		//Free every image and texture
+		void clear();
+};
+
+#endif
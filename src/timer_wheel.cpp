@@ -0,0 +1,192 @@
+#include "timer_wheel.h"
+
+/**
+ * clear
+ * \brief Remove every timer and go back to tick 0
+ * \return void
+ **/
+void TimerWheel::clear()
+{
+	timers.clear();
+	free_timers.clear();
+	for(int lLevel = 0; lLevel < LEVELS; lLevel++)
+	{
+		for(int lSlot = 0; lSlot < SLOTS; lSlot++)
+		{
+			slots[lLevel][lSlot] = -1;
+		}
+	}
+	now = 0;
+}
+
+/**
+ * insert
+ * \param pTimer : Timer index
+ * \brief Put a timer in the lowest level whose slot is visited at or before
+ *        its expiry (the last level if it is too far)
+ * \return void
+ **/
+void TimerWheel::insert(int pTimer)
+{
+	Uint32 lExpires = timers[pTimer].expires;
+	int lLevel = 0;
+	Uint32 lSlot = lExpires & SLOT_MASK;
+
+	if(lExpires - now >= (Uint32)SLOTS)
+	{
+		lLevel = LEVELS - 1;
+		lSlot = ((now >> (SLOT_BITS * lLevel)) + SLOT_MASK) & SLOT_MASK;
+		for(int lUpper = 1; lUpper < LEVELS; lUpper++)
+		{
+			int lShift = SLOT_BITS * lUpper;
+			if((lExpires >> lShift) - (now >> lShift) < (Uint32)SLOTS)
+			{
+				lLevel = lUpper;
+				lSlot = (lExpires >> lShift) & SLOT_MASK;
+				break;
+			}
+		}
+	}
+
+	timers[pTimer].next = slots[lLevel][lSlot];
+	slots[lLevel][lSlot] = pTimer;
+}
+
+/**
+ * cascade
+ * \param pLevel : Upper level
+ * \param pSlot : Slot reached by the current tick
+ * \brief Take the timers of an upper slot and place them again (closer to
+ *        their expiry, the cancelled ones are freed)
+ * \return void
+ **/
+void TimerWheel::cascade(int pLevel, Uint32 pSlot)
+{
+	int lTimer = slots[pLevel][pSlot];
+	slots[pLevel][pSlot] = -1;
+
+	while(lTimer != -1)
+	{
+		int lNext = timers[lTimer].next;
+		if(timers[lTimer].is_active)
+		{
+			insert(lTimer);
+		}
+		else
+		{
+			free_timers.push_back(lTimer);
+		}
+		lTimer = lNext;
+	}
+}
+
+/**
+ * schedule
+ * \param pEvent : Event given back when the timer is due
+ * \param pDelay : Ticks before the first time (at least 1)
+ * \param pPeriod : Ticks between two times (0 for once)
+ * \brief Add a timer
+ * \return int : timer (for cancel)
+ **/
+int TimerWheel::schedule(int pEvent, Uint32 pDelay, Uint32 pPeriod)
+{
+	int lTimer;
+	if(!free_timers.empty())
+	{
+		lTimer = free_timers.back();
+		free_timers.pop_back();
+	}
+	else
+	{
+		lTimer = (int)timers.size();
+		timers.push_back(Timer());
+	}
+
+	Timer& lNew = timers[lTimer];
+	lNew.expires = now + SDL_max(pDelay, 1u);
+	lNew.period = pPeriod;
+	lNew.event = pEvent;
+	lNew.next = -1;
+	lNew.is_active = true;
+
+	insert(lTimer);
+	return lTimer;
+}
+
+/**
+ * cancel
+ * \param pTimer : Timer
+ * \brief Remove a timer (freed when its slot is visited)
+ * \return void
+ **/
+void TimerWheel::cancel(int pTimer)
+{
+	timers[pTimer].is_active = false;
+}
+
+/**
+ * advance
+ * \param pDue : Due events (output, added at the end)
+ * \brief Move to the next tick: cascade the upper slots reached, then give
+ *        the events of the current slot and reschedule the periodic ones
+ * \return void
+ **/
+void TimerWheel::advance(std::vector<int>& pDue)
+{
+	now++;
+
+	//Upper blocks reached (from the highest)
+	for(int lLevel = LEVELS - 1; lLevel > 0; lLevel--)
+	{
+		Uint32 lLowMask = (1u << (SLOT_BITS * lLevel)) - 1;
+		if((now & lLowMask) == 0)
+		{
+			cascade(lLevel, (now >> (SLOT_BITS * lLevel)) & SLOT_MASK);
+		}
+	}
+
+	int lTimer = slots[0][now & SLOT_MASK];
+	slots[0][now & SLOT_MASK] = -1;
+
+	//Taken in scheduling order: the slot list is built in reverse
+	int lPrevious = -1;
+	while(lTimer != -1)
+	{
+		int lNext = timers[lTimer].next;
+		timers[lTimer].next = lPrevious;
+		lPrevious = lTimer;
+		lTimer = lNext;
+	}
+
+	lTimer = lPrevious;
+	while(lTimer != -1)
+	{
+		Timer& lDue = timers[lTimer];
+		int lNext = lDue.next;
+
+		if(!lDue.is_active)
+		{
+			free_timers.push_back(lTimer);
+		}
+		else if(lDue.expires != now)
+		{
+			//Waited on the last level
+			insert(lTimer);
+		}
+		else
+		{
+			pDue.push_back(lDue.event);
+			if(lDue.period > 0)
+			{
+				lDue.expires += lDue.period;
+				insert(lTimer);
+			}
+			else
+			{
+				lDue.is_active = false;
+				free_timers.push_back(lTimer);
+			}
+		}
+		lTimer = lNext;
+	}
+}
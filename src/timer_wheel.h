@@ -0,0 +1,73 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <vector>
+#include <SDL2/SDL.h>
+
+/**
+ * \class TimerWheel
+ * \brief Hierarchical timer wheel of periodic events counted in ticks: a
+ *        tick only visits the slot of the timers due, the far timers wait
+ *        on the upper levels and cascade down as their time comes
+ *
+ * Level l slot s holds the timers expiring in the s-th block of 64^l ticks
+ * (level 0 exactly at tick s). Timers beyond the last level wait on it and
+ * are placed again when it cascades.
+ **/
+class TimerWheel
+{
+	private:
+		static const int LEVELS = 3;
+		static const int SLOT_BITS = 6;
+		static const int SLOTS = 1 << SLOT_BITS;
+		static const Uint32 SLOT_MASK = SLOTS - 1;
+
+		struct Timer
+		{
+			Uint32 expires;
+			Uint32 period;
+			int event;
+			//Next timer of the slot (-1 at the end)
+			int next;
+			bool is_active;
+		};
+
+		std::vector<Timer> timers;
+		std::vector<int> free_timers;
+
+		//First timer of every slot (-1 if empty)
+		int slots[LEVELS][SLOTS];
+
+		//Current tick
+		Uint32 now;
+
+		//Put a timer in the slot of its expiry
+		void insert(int pTimer);
+
+		//Take the timers of an upper slot and place them again
+		void cascade(int pLevel, Uint32 pSlot);
+
+	public:
+		//Constructor
+		TimerWheel()
+		{
+			clear();
+		}
+
+		//Remove every timer and go back to tick 0
+		void clear();
+
+		//Add an event due in pDelay ticks (at least 1), then every pPeriod ticks (0 for once)
+		int schedule(int pEvent, Uint32 pDelay, Uint32 pPeriod=0);
+
+		//Remove a timer
+		void cancel(int pTimer);
+
+		//Move to the next tick and add its due events (in scheduling order of the slot)
+		void advance(std::vector<int>& pDue);
+
+		//Getter for the current tick
+		Uint32 get_now(){return now;}
+};
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <atomic>
+
+/**
+ * \class TripleBuffer
+ * \brief Latest value published by a writer thread to a reader thread without
+ *        lock nor wait: the writer fills its back buffer and swaps it with the
+ *        middle one, the reader swaps its front buffer with the middle one when
+ *        a newer value was published (older unread values are skipped)
+ **/
+template<class T>
+class TripleBuffer
+{
+	private:
+		//Set on the middle index when it holds a value not read yet
+		static const int FRESH = 4;
+
+		T buffers[3];
+		int back{0};
+		int front{1};
+		std::atomic<int> middle{2};
+
+	public:
+		//Getter for the buffer being written (writer thread)
+		T& write_buffer(){return buffers[back];}
+
+		/**
+		 * publish (writer thread)
+		 * \brief Make the written buffer the latest value, write into another one
+		 * \return void
+		 **/
+		void publish()
+		{
+			back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & ~FRESH;
+		}
+
+		/**
+		 * update (reader thread)
+		 * \brief Take the latest published value, if there is a new one
+		 * \return boolean : new value status
+		 **/
+		bool update()
+		{
+			if((middle.load(std::memory_order_acquire) & FRESH) == 0)
+			{
+				return false;
+			}
+			front = middle.exchange(front, std::memory_order_acq_rel) & ~FRESH;
+			return true;
+		}
+
+		//Getter for the value taken by the last update (reader thread)
+		const T& read_buffer(){return buffers[front];}
+};
+
+#endif
@@ -0,0 +1,218 @@
+#include "vfs.h"
+#include <sys/stat.h>
+
+/**
+ * mount
+ * \param pPrefix : Virtual names prefix (e.g. assets/, empty for every name)
+ * \param pArchive : Mounted archive
+ * \param pTarget : Path prefix of the files in the archive
+ * \param pUseLooseFiles : Use the loose files of the archive root path too
+ * \brief Mount an archive, last mounted archives override the previous ones
+ * \return void
+ **/
+void Vfs::mount(std::string pPrefix, AssetArchive* pArchive, std::string pTarget, bool pUseLooseFiles)
+{
+	std::lock_guard<std::mutex> lGuard(lock);
+
+	Mount lMount;
+	lMount.prefix = pPrefix;
+	lMount.archive = pArchive;
+	lMount.target = pTarget;
+	lMount.use_loose_files = pUseLooseFiles;
+	mounts.insert(mounts.begin(), lMount);
+
+	//Mount points changed : resolve the interned assets again
+	for(auto &lEntry : entries)
+	{
+		resolve(lEntry);
+	}
+}
+
+/**
+ * resolve
+ * \param pEntry : Asset entry
+ * \brief Find the source of an asset through the mount points
+ * \return void
+ **/
+void Vfs::resolve(Entry& pEntry)
+{
+	pEntry.found = false;
+	pEntry.in_archive = false;
+	pEntry.archive = nullptr;
+	pEntry.stamp = 0;
+
+	for(auto &lMount : mounts)
+	{
+		if(pEntry.name.compare(0, lMount.prefix.size(), lMount.prefix) != 0)
+		{
+			continue;
+		}
+
+		std::string lPath = lMount.target + pEntry.name.substr(lMount.prefix.size());
+		if(lMount.archive->find(lPath, &pEntry.offset, &pEntry.size))
+		{
+			pEntry.found = true;
+			pEntry.in_archive = true;
+			pEntry.archive = lMount.archive;
+			pEntry.stamp = lMount.archive->get_stamp();
+			return;
+		}
+
+		if(lMount.use_loose_files)
+		{
+			struct stat lStat;
+			std::string lFilePath = lMount.archive->get_root_path() + lPath;
+			if(stat(lFilePath.c_str(), &lStat) == 0 && (lStat.st_mode & S_IFMT) == S_IFREG)
+			{
+				pEntry.found = true;
+				pEntry.file_path = lFilePath;
+				pEntry.stamp = lStat.st_mtime;
+				return;
+			}
+		}
+	}
+}
+
+/**
+ * intern
+ * \param pName : File name (e.g. assets/spike.png)
+ * \brief Intern a file name, its source is resolved once
+ * \return AssetId : asset ID
+ **/
+AssetId Vfs::intern(std::string pName)
+{
+	std::lock_guard<std::mutex> lGuard(lock);
+
+	auto lIt = ids.find(pName);
+	if(lIt != ids.end())
+	{
+		return lIt->second;
+	}
+
+	Entry lEntry;
+	lEntry.name = pName;
+	resolve(lEntry);
+
+	AssetId lId = entries.size();
+	entries.push_back(lEntry);
+	ids[pName] = lId;
+
+	return lId;
+}
+
+/**
+ * get_name
+ * \param pId : Asset ID
+ * \brief Getter for the name of an asset
+ * \return std::string : asset name
+ **/
+std::string Vfs::get_name(AssetId pId)
+{
+	std::lock_guard<std::mutex> lGuard(lock);
+
+	if(pId >= entries.size())
+	{
+		return "";
+	}
+	return entries[pId].name;
+}
+
+/**
+ * exists
+ * \param pId : Asset ID
+ * \brief Check if an asset exists
+ * \return boolean : asset exists status
+ **/
+bool Vfs::exists(AssetId pId)
+{
+	std::lock_guard<std::mutex> lGuard(lock);
+
+	return pId < entries.size() && entries[pId].found;
+}
+
+/**
+ * open
+ * \param pId : Asset ID
+ * \brief Open an asset for reading
+ * \return SDL_RWops* : asset stream (nullptr if not found)
+ **/
+SDL_RWops* Vfs::open(AssetId pId)
+{
+	std::lock_guard<std::mutex> lGuard(lock);
+
+	if(pId >= entries.size() || !entries[pId].found)
+	{
+		return nullptr;
+	}
+
+	Entry& lEntry = entries[pId];
+	if(lEntry.in_archive)
+	{
+		return lEntry.archive->open(lEntry.offset, lEntry.size);
+	}
+	return SDL_RWFromFile(lEntry.file_path.c_str(), "rb");
+}
+
+/**
+ * get_stamp
+ * \param pId : Asset ID
+ * \brief Getter for the modification time of the asset source (file or archive)
+ * \return Uint64 : modification time (0 if not found)
+ **/
+Uint64 Vfs::get_stamp(AssetId pId)
+{
+	std::lock_guard<std::mutex> lGuard(lock);
+
+	if(pId >= entries.size())
+	{
+		return 0;
+	}
+	return entries[pId].stamp;
+}
+
+/**
+ * read
+ * \param pId : Asset ID
+ * \param pContent : Asset content (output)
+ * \brief Read a whole text asset
+ * \return boolean : read status
+ **/
+bool Vfs::read(AssetId pId, std::string& pContent)
+{
+	SDL_RWops* lFile = open(pId);
+	if(lFile == nullptr)
+	{
+		return false;
+	}
+
+	size_t lSize{0};
+	void* lData = SDL_LoadFile_RW(lFile, &lSize, 1);
+	if(lData == nullptr)
+	{
+		return false;
+	}
+
+	pContent.assign((const char*)lData, lSize);
+	SDL_free(lData);
+	return true;
+}
+
+/**
+ * map
+ * \param pId : Asset ID
+ * \param pSize : Asset size (output)
+ * \brief Getter for the bytes of an archived asset, in the archive mapping
+ * \return const Uint8* : asset bytes (nullptr if not archived)
+ **/
+const Uint8* Vfs::map(AssetId pId, Uint32* pSize)
+{
+	std::lock_guard<std::mutex> lGuard(lock);
+
+	if(pId >= entries.size() || !entries[pId].in_archive)
+	{
+		return nullptr;
+	}
+
+	*pSize = entries[pId].size;
+	return entries[pId].archive->get_data(entries[pId].offset);
+}
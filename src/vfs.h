@@ -0,0 +1,86 @@
+#ifndef VFS_H
+#define VFS_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <mutex>
+#include <SDL2/SDL.h>
+#include "asset_archive.h"
+
+//Interned game file (index in the Vfs table)
+typedef Uint32 AssetId;
+
+/**
+ * \class Vfs
+ * \brief Virtual filesystem: mount points (base assets and data, override
+ *        packs) and interned asset IDs resolved once to their source
+ *        (thread-safe: levels are prefetched on a worker thread)
+ **/
+class Vfs
+{
+	private:
+		struct Mount
+		{
+			std::string prefix;
+			AssetArchive* archive;
+			std::string target;
+			bool use_loose_files;
+		};
+
+		struct Entry
+		{
+			std::string name;
+			bool found;
+			bool in_archive;
+			AssetArchive* archive;
+			Uint32 offset;
+			Uint32 size;
+			std::string file_path;
+			Uint64 stamp;
+		};
+
+		//Last mounted first
+		std::vector<Mount> mounts;
+
+		std::vector<Entry> entries;
+		std::unordered_map<std::string, AssetId> ids;
+
+		//Guards the mount points and the entries
+		std::mutex lock;
+
+		//Find the source of an entry through the mount points
+		void resolve(Entry& pEntry);
+
+	public:
+		static const AssetId INVALID_ASSET = 0xFFFFFFFF;
+
+		//Constructor
+		Vfs(){};
+
+		//Mount an archive (and its loose files) for the names starting with the prefix
+		void mount(std::string pPrefix, AssetArchive* pArchive, std::string pTarget, bool pUseLooseFiles);
+
+		//Intern a file name (e.g. assets/spike.png)
+		AssetId intern(std::string pName);
+
+		//Getter for the name of an asset
+		std::string get_name(AssetId pId);
+
+		//Check if an asset exists
+		bool exists(AssetId pId);
+
+		//Open an asset for reading
+		SDL_RWops* open(AssetId pId);
+
+		//Getter for the modification time of an asset source (cache keys)
+		Uint64 get_stamp(AssetId pId);
+
+		//Read a whole text asset
+		bool read(AssetId pId, std::string& pContent);
+
+		//Getter for the mapped bytes of an archived asset (nullptr for loose files)
+		const Uint8* map(AssetId pId, Uint32* pSize);
+};
+
+#endif
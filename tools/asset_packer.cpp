@@ -0,0 +1,207 @@
+/**
+ * Asset archive packer for LD32 game Eraser
+ * Packs every file under assets/ and data/ into eraser.pak (see
+ * AssetArchive for the layout).
+ */
+
+#include "../src/asset_archive.h"
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#undef main
+
+//Packed directories (relative to the game base path)
+static const char* PACKED_DIRS[] = {"assets", "data"};
+
+/**
+ * \struct PackedFile
+ * \brief Archived file and its position in the archive
+ **/
+struct PackedFile
+{
+	std::string name;
+	std::string content;
+	Uint32 name_offset;
+	Uint32 data_offset;
+};
+
+/**
+ * list_files
+ * \param pRootPath : Game base path
+ * \param pDir : Directory to list (relative path)
+ * \param pFiles : Listed files (relative paths)
+ * \brief List the files of a directory recursively
+ * \return void
+ **/
+static void list_files(std::string pRootPath, std::string pDir, std::vector<std::string>& pFiles)
+{
+	DIR* lDir = opendir((pRootPath + pDir).c_str());
+	if(lDir == nullptr)
+	{
+		return;
+	}
+
+	struct dirent* lEntry;
+	while((lEntry = readdir(lDir)) != nullptr)
+	{
+		std::string lName = lEntry->d_name;
+		if(lName.empty() || lName[0] == '.')
+		{
+			continue;
+		}
+
+		std::string lPath = pDir + "/" + lName;
+		struct stat lStat;
+		if(stat((pRootPath + lPath).c_str(), &lStat) < 0)
+		{
+			continue;
+		}
+
+		if(S_ISDIR(lStat.st_mode))
+		{
+			list_files(pRootPath, lPath, pFiles);
+		}
+		else if(S_ISREG(lStat.st_mode))
+		{
+			pFiles.push_back(lPath);
+		}
+	}
+	closedir(lDir);
+}
+
+/**
+ * write_u32
+ * \param pOut : Output archive
+ * \param pValue : Value
+ * \brief Write a little-endian 32 bits value
+ * \return void
+ **/
+static void write_u32(std::ofstream& pOut, Uint32 pValue)
+{
+	char lBytes[4] = {(char)(pValue & 0xFF), (char)((pValue >> 8) & 0xFF), (char)((pValue >> 16) & 0xFF), (char)((pValue >> 24) & 0xFF)};
+	pOut.write(lBytes, 4);
+}
+
+/**
+ * Main program
+ * \brief Pack the game files of the given base path into eraser.pak
+ **/
+int main(int argc, char* argv[])
+{
+	std::string root_path = (argc > 1) ? argv[1] : "./";
+	if(root_path[root_path.size() - 1] != '/')
+	{
+		root_path += "/";
+	}
+	std::string archive_path = (argc > 2) ? argv[2] : root_path + "eraser.pak";
+
+	std::vector<std::string> names;
+	for(auto lDir : PACKED_DIRS)
+	{
+		list_files(root_path, lDir, names);
+	}
+	std::sort(names.begin(), names.end());
+
+	if(names.empty())
+	{
+		std::cerr << "Nothing to pack in " << root_path << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	//Directory size : power of 2, at most half full
+	Uint32 slot_count{1};
+	while(slot_count < 2 * names.size())
+	{
+		slot_count *= 2;
+	}
+
+	//Layout : header, slots, names, data
+	std::vector<PackedFile> files;
+	Uint32 lOffset = AssetArchive::HEADER_SIZE + slot_count * AssetArchive::SLOT_SIZE;
+	for(auto &lName : names)
+	{
+		PackedFile lFile;
+		lFile.name = lName;
+		lFile.name_offset = lOffset;
+		lOffset += lName.size() + 1;
+
+		std::ifstream lIn(root_path + lName, std::ios::binary);
+		if(!lIn.is_open())
+		{
+			std::cerr << "Cannot read " << lName << std::endl;
+			return EXIT_FAILURE;
+		}
+		lFile.content.assign(std::istreambuf_iterator<char>(lIn), std::istreambuf_iterator<char>());
+		files.push_back(lFile);
+	}
+
+	for(auto &lFile : files)
+	{
+		lFile.data_offset = lOffset;
+		lOffset += lFile.content.size();
+	}
+
+	//Hashed directory (open addressing, linear probing)
+	std::vector<int> slots(slot_count, -1);
+	for(size_t lIdx = 0; lIdx < files.size(); lIdx++)
+	{
+		Uint32 lSlot = AssetArchive::hash(files[lIdx].name) & (slot_count - 1);
+		while(slots[lSlot] != -1)
+		{
+			lSlot = (lSlot + 1) & (slot_count - 1);
+		}
+		slots[lSlot] = lIdx;
+	}
+
+	std::ofstream out(archive_path, std::ios::binary);
+	if(!out.is_open())
+	{
+		std::cerr << "Cannot write " << archive_path << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	out.write("EPAK", 4);
+	write_u32(out, AssetArchive::VERSION);
+	write_u32(out, files.size());
+	write_u32(out, slot_count);
+
+	for(auto lSlot : slots)
+	{
+		if(lSlot == -1)
+		{
+			for(int lIdx = 0; lIdx < 4; lIdx++)
+			{
+				write_u32(out, 0);
+			}
+			continue;
+		}
+
+		PackedFile& lFile = files[lSlot];
+		write_u32(out, AssetArchive::hash(lFile.name));
+		write_u32(out, lFile.name_offset);
+		write_u32(out, lFile.data_offset);
+		write_u32(out, lFile.content.size());
+	}
+
+	for(auto &lFile : files)
+	{
+		out.write(lFile.name.c_str(), lFile.name.size() + 1);
+	}
+
+	for(auto &lFile : files)
+	{
+		out.write(lFile.content.data(), lFile.content.size());
+	}
+	out.close();
+
+	std::cout << "Packed " << files.size() << " files into " << archive_path << " (" << lOffset << " bytes)" << std::endl;
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,156 @@
+/**
+ * Sprite atlas packer for LD32 game Eraser
+ * Packs the game sprite sheets into atlas.png and writes the sub-rects
+ * manifest atlas.idx (lines of "name x y w h") next to them.
+ */
+
+#include <SDL2/SDL.h>
+
+#ifdef __APPLE__
+#include <SDL2_image/SDL_image.h>
+#else
+#include <SDL2/SDL_image.h>
+#endif
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#undef main
+
+//Sheets resolved through the atlas at runtime
+static const char* SHEET_NAMES[] = {
+	"playersheet", "spike", "plant", "arachne", "ghost", "monster",
+	"timer", "pencil", "hole", "ground", "eraser", "bt_sheet"
+};
+
+static const int ATLAS_WIDTH = 512;
+static const int PADDING = 1;
+
+/**
+ * \struct PackedSheet
+ * \brief Sheet image and its area in the atlas
+ **/
+struct PackedSheet
+{
+	std::string name;
+	SDL_Surface* image;
+	SDL_Rect rect;
+};
+
+/**
+ * Main program
+ * \brief Pack the sprite sheets of the given assets directory
+ **/
+int main(int argc, char* argv[])
+{
+	std::string asset_path = (argc > 1) ? argv[1] : "assets/";
+	if(asset_path[asset_path.size() - 1] != '/')
+	{
+		asset_path += "/";
+	}
+
+	if(SDL_Init(0) < 0 || IMG_Init(IMG_INIT_PNG) == 0)
+	{
+		std::cerr << "Cannot initialize SDL: " << SDL_GetError() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	//Load every sheet
+	std::vector<PackedSheet> sheets;
+	for(auto lName : SHEET_NAMES)
+	{
+		PackedSheet lSheet;
+		lSheet.name = lName;
+		lSheet.image = IMG_Load((asset_path + lSheet.name + ".png").c_str());
+		if(lSheet.image == nullptr)
+		{
+			std::cerr << "Cannot load sheet " << lSheet.name << ": " << IMG_GetError() << std::endl;
+			return EXIT_FAILURE;
+		}
+		lSheet.rect.x = 0;
+		lSheet.rect.y = 0;
+		lSheet.rect.w = lSheet.image->w;
+		lSheet.rect.h = lSheet.image->h;
+		sheets.push_back(lSheet);
+	}
+
+	//Shelf packing, tallest sheets first
+	std::sort(sheets.begin(), sheets.end(), [](const PackedSheet& pA, const PackedSheet& pB)
+	{
+		return pA.rect.h > pB.rect.h;
+	});
+
+	int lX{0};
+	int lY{0};
+	int lShelfHeight{0};
+	for(auto &lSheet : sheets)
+	{
+		if(lSheet.rect.w > ATLAS_WIDTH)
+		{
+			std::cerr << "Sheet " << lSheet.name << " is wider than the atlas" << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		if(lX + lSheet.rect.w > ATLAS_WIDTH)
+		{
+			lX = 0;
+			lY += lShelfHeight + PADDING;
+			lShelfHeight = 0;
+		}
+
+		lSheet.rect.x = lX;
+		lSheet.rect.y = lY;
+		lX += lSheet.rect.w + PADDING;
+		lShelfHeight = std::max(lShelfHeight, lSheet.rect.h);
+	}
+
+	//Blit the sheets into a transparent atlas
+	SDL_Surface* atlas = SDL_CreateRGBSurfaceWithFormat(0, ATLAS_WIDTH, lY + lShelfHeight, 32, SDL_PIXELFORMAT_RGBA32);
+	if(atlas == nullptr)
+	{
+		std::cerr << "Cannot create the atlas: " << SDL_GetError() << std::endl;
+		return EXIT_FAILURE;
+	}
+	SDL_FillRect(atlas, nullptr, 0);
+
+	for(auto &lSheet : sheets)
+	{
+		SDL_Rect lDest = lSheet.rect;
+		SDL_SetSurfaceBlendMode(lSheet.image, SDL_BLENDMODE_NONE);
+		SDL_BlitSurface(lSheet.image, nullptr, atlas, &lDest);
+		SDL_FreeSurface(lSheet.image);
+	}
+
+	if(IMG_SavePNG(atlas, (asset_path + "atlas.png").c_str()) < 0)
+	{
+		std::cerr << "Cannot save the atlas: " << IMG_GetError() << std::endl;
+		return EXIT_FAILURE;
+	}
+	SDL_FreeSurface(atlas);
+
+	//Write the manifest
+	std::ofstream index_file(asset_path + "atlas.idx");
+	if(!index_file.is_open())
+	{
+		std::cerr << "Cannot write the atlas manifest" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	index_file << "# name x y w h" << std::endl;
+	for(auto &lSheet : sheets)
+	{
+		index_file << lSheet.name << " " << lSheet.rect.x << " " << lSheet.rect.y << " "
+			<< lSheet.rect.w << " " << lSheet.rect.h << std::endl;
+	}
+	index_file.close();
+
+	std::cout << "Packed " << sheets.size() << " sheets into " << asset_path << "atlas.png" << std::endl;
+
+	IMG_Quit();
+	SDL_Quit();
+	return EXIT_SUCCESS;
+}
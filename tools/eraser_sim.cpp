@@ -0,0 +1,172 @@
+/**
+ * Headless simulation for LD32 game Eraser
+ * Plays every level of lvl_index with random inputs through the eraser_core
+ * library (null renderer and audio: no window nor audio device needed) and
+ * reports the outcomes and the simulated levels per second. A level id can
+ * be given to play only this level (a generated huge map for instance).
+ */
+
+#include "../src/level.h"
+#include "../src/asset_archive.h"
+#include "../src/vfs.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#undef main
+
+//Simulated frame (ms)
+static const Uint32 FRAME_TIME = 16;
+
+/**
+ * random_event
+ * \param pRandom : Input generator
+ * \param pEvent : Generated event (output)
+ * \brief Pick a random player input (arrow key or eraser click), or nothing
+ * \return boolean : event generated status
+ **/
+static bool random_event(std::mt19937& pRandom, SDL_Event* pEvent)
+{
+	SDL_zerop(pEvent);
+	switch(pRandom() % 8)
+	{
+		case 0:
+			pEvent->type = SDL_KEYDOWN;
+			pEvent->key.keysym.sym = SDLK_LEFT;
+			return true;
+		case 1:
+		case 2:
+			pEvent->type = SDL_KEYDOWN;
+			pEvent->key.keysym.sym = SDLK_RIGHT;
+			return true;
+		case 3:
+			pEvent->type = SDL_KEYDOWN;
+			pEvent->key.keysym.sym = SDLK_UP;
+			return true;
+		case 4:
+			pEvent->type = SDL_MOUSEBUTTONDOWN;
+			pEvent->motion.x = pRandom() % 1024;
+			pEvent->motion.y = pRandom() % 768;
+			return true;
+	}
+	return false;
+}
+
+/**
+ * Main program
+ * \brief Simulate every level the given number of times
+ **/
+int main(int argc, char* argv[])
+{
+	int lRuns = (argc > 1) ? atoi(argv[1]) : 1000;
+	std::string lBasePath = (argc > 2) ? argv[2] : "./";
+	if(lRuns <= 0)
+	{
+		std::cerr << "Usage: " << argv[0] << " [runs per level] [game path] [level id]" << std::endl;
+		return EXIT_FAILURE;
+	}
+	if(lBasePath.back() != '/')
+	{
+		lBasePath += "/";
+	}
+
+	//Same mount points as the game
+	AssetArchive lAssets;
+	lAssets.mount(lBasePath, "eraser.pak");
+	Vfs lVfs;
+	lVfs.mount("assets/", &lAssets, "assets/", true);
+	lVfs.mount("data/", &lAssets, "data/", true);
+
+	LevelAssets lLevelAssets;
+	lLevelAssets.init(&lVfs, "assets/");
+
+	NullRenderer lRenderer;
+	NullAudio lAudio;
+	LevelContext lContext;
+	lContext.assets = &lLevelAssets;
+	lContext.vfs = &lVfs;
+	lContext.audio = &lAudio;
+	lContext.renderer = &lRenderer;
+
+	std::vector<std::string> lLevelIds;
+	if(argc > 3)
+	{
+		lLevelIds.push_back(argv[3]);
+	}
+	else
+	{
+		std::string lIndex;
+		if(!lVfs.read(lVfs.intern("data/lvl_index"), lIndex))
+		{
+			std::cerr << "Cannot read data/lvl_index" << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		std::istringstream lIndexFile(lIndex);
+		std::string lLine;
+		while(getline(lIndexFile, lLine))
+		{
+			if(!lLine.empty())
+			{
+				lLevelIds.push_back(lLine);
+			}
+		}
+	}
+
+	std::mt19937 lRandom(32);
+	int lOutcomes[4] = {0, 0, 0, 0};
+	Uint64 lFrames{0};
+	Uint64 lStart = SDL_GetPerformanceCounter();
+
+	for(auto &lLevelId : lLevelIds)
+	{
+		AssetId lMapId = lVfs.intern("data/" + lLevelId + "/lvl_map");
+		AssetId lBgId = lVfs.intern("data/" + lLevelId + "/bg.png");
+
+		for(int lRun = 0; lRun < lRuns; lRun++)
+		{
+			Level lLevel(lMapId, lBgId, &lContext);
+			if(!lLevel.load_headless())
+			{
+				return EXIT_FAILURE;
+			}
+
+			//Simulated clock: one frame per step, as fast as possible
+			Uint32 lTime{0};
+			int lState = Level::PLAYING;
+			while(lState == Level::PLAYING)
+			{
+				lTime += FRAME_TIME;
+				lState = lLevel.update(lTime);
+				lLevel.render(nullptr);
+
+				SDL_Event lEvent;
+				if(lState == Level::PLAYING && random_event(lRandom, &lEvent))
+				{
+					lLevel.on_event(&lEvent);
+				}
+				lFrames++;
+			}
+			lOutcomes[lState]++;
+			lLevel.unload();
+		}
+	}
+
+	double lElapsed = (double)(SDL_GetPerformanceCounter() - lStart) / SDL_GetPerformanceFrequency();
+	int lTotal = lRuns * (int)lLevelIds.size();
+
+	std::cout << lTotal << " levels, " << lFrames << " frames in " << lElapsed << " s" << std::endl;
+	std::cout << "Finished: " << lOutcomes[Level::FINISHED]
+		<< ", failed: " << lOutcomes[Level::FAILED]
+		<< ", time out: " << lOutcomes[Level::TIME_OUT] << std::endl;
+	if(lElapsed > 0)
+	{
+		std::cout << (lTotal / lElapsed) << " levels/s, " << (lFrames / lElapsed) << " frames/s" << std::endl;
+	}
+
+	return EXIT_SUCCESS;
+}
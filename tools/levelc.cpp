@@ -0,0 +1,257 @@
+/**
+ * Level compiler for LD32 game Eraser
+ * Validates text level maps (lvl_map) and writes their compiled form
+ * next to them (lvl_map.bin, see LevelMap for the layout). Maps larger than
+ * a sheet are also written in chunks (lvl_map.chunks, see ChunkFile),
+ * streamed around the player by the game.
+ *
+ * levelc --stress width height output generates a chunked map of the given
+ * size (tiles) chunk by chunk, to play huge levels.
+ */
+
+#include "../src/level_map.h"
+#include "../src/chunk_file.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+
+#undef main
+
+/**
+ * compile
+ * \param pMapPath : Text level map
+ * \brief Validate a level map and write its compiled form (pMapPath.bin)
+ * \return boolean : compile status
+ **/
+static bool compile(std::string pMapPath)
+{
+	std::ifstream lIn(pMapPath, std::ios::binary);
+	if(!lIn.is_open())
+	{
+		std::cerr << pMapPath << ": cannot read the level map" << std::endl;
+		return false;
+	}
+	std::string lContent((std::istreambuf_iterator<char>(lIn)), std::istreambuf_iterator<char>());
+
+	LevelMap lMap;
+	bool lStatus = lMap.parse_text(lContent);
+
+	for(auto &lWarning : lMap.warnings)
+	{
+		std::cerr << pMapPath << ": warning: " << lWarning << std::endl;
+	}
+
+	for(auto &lError : lMap.errors)
+	{
+		std::cerr << pMapPath << ": " << lError << std::endl;
+	}
+
+	if(!lStatus)
+	{
+		return false;
+	}
+
+	std::string lBinary;
+	lMap.write_binary(lBinary);
+
+	std::string lBinPath = pMapPath + ".bin";
+	std::ofstream lOut(lBinPath, std::ios::binary);
+	if(!lOut.is_open())
+	{
+		std::cerr << "Cannot write " << lBinPath << std::endl;
+		return false;
+	}
+	lOut.write(lBinary.data(), lBinary.size());
+
+	std::cout << lBinPath << ": " << lMap.ground.size() << " ground rects, "
+		<< lMap.entities.size() << " entities" << std::endl;
+
+	//Streamed by the game when it does not fit in a sheet
+	if(lMap.width > LevelMap::SHEET_WIDTH || lMap.height > LevelMap::SHEET_HEIGHT)
+	{
+		std::string lChunked;
+		ChunkFile::write(lMap, lChunked);
+
+		std::string lChunksPath = pMapPath + ".chunks";
+		std::ofstream lChunksOut(lChunksPath, std::ios::binary);
+		if(!lChunksOut.is_open())
+		{
+			std::cerr << "Cannot write " << lChunksPath << std::endl;
+			return false;
+		}
+		lChunksOut.write(lChunked.data(), lChunked.size());
+
+		std::cout << lChunksPath << ": " << lMap.width << "x" << lMap.height << " tiles" << std::endl;
+	}
+	return true;
+}
+
+/**
+ * generate_chunk
+ * \param pRandom : Content generator
+ * \param pChunk : Chunk to fill (coordinates set)
+ * \brief Fill a chunk with a platform and sometimes a spike, a time bonus or
+ *        a monster on it (half of the chunks are left empty)
+ * \return void
+ **/
+static void generate_chunk(std::mt19937& pRandom, ChunkData& pChunk)
+{
+	pChunk.ground.clear();
+	pChunk.entities.clear();
+	if(pRandom() % 2 == 0)
+	{
+		return;
+	}
+
+	int lTileX = pChunk.x * ChunkFile::CHUNK_TILES;
+	int lTileY = pChunk.y * ChunkFile::CHUNK_TILES + 2 + pRandom() % (ChunkFile::CHUNK_TILES - 2);
+	int lStart = lTileX + pRandom() % (ChunkFile::CHUNK_TILES / 2);
+	int lLength = 2 + pRandom() % (ChunkFile::CHUNK_TILES / 2 - 1);
+
+	for(int lX = lStart; lX < lStart + lLength; lX++)
+	{
+		SDL_Rect lRect;
+		lRect.w = LevelMap::TILE_SIZE;
+		lRect.h = LevelMap::GROUND_HEIGHT;
+		lRect.x = lX * LevelMap::TILE_SIZE;
+		lRect.y = lTileY * LevelMap::TILE_SIZE;
+		pChunk.ground.push_back(lRect);
+	}
+
+	LevelMap::Entity lEntity;
+	lEntity.y = lTileY - 1;
+	lEntity.x = lStart + pRandom() % lLength;
+	lEntity.x_end = lEntity.x;
+	switch(pRandom() % 4)
+	{
+		case 0:
+			lEntity.type = 'S';
+			break;
+		case 1:
+			lEntity.type = 'T';
+			break;
+		case 2:
+			lEntity.type = LevelMap::MONSTER;
+			lEntity.x = lStart;
+			lEntity.x_end = lStart + lLength - 1;
+			break;
+		default:
+			return;
+	}
+	pChunk.entities.push_back(lEntity);
+}
+
+/**
+ * generate_stress
+ * \param pWidth : Map width (tiles)
+ * \param pHeight : Map height (tiles)
+ * \param pPath : Chunked map to write
+ * \brief Generate a chunked map chunk by chunk (the map is never held whole:
+ *        the index is written once every chunk has been written)
+ * \return boolean : generate status
+ **/
+static bool generate_stress(int pWidth, int pHeight, std::string pPath)
+{
+	std::ofstream lOut(pPath, std::ios::binary);
+	if(!lOut.is_open())
+	{
+		std::cerr << "Cannot write " << pPath << std::endl;
+		return false;
+	}
+
+	int lChunksX = (pWidth + ChunkFile::CHUNK_TILES - 1) / ChunkFile::CHUNK_TILES;
+	int lChunksY = (pHeight + ChunkFile::CHUNK_TILES - 1) / ChunkFile::CHUNK_TILES;
+
+	//Player on the top left, door on the bottom right
+	std::string lHeader;
+	ChunkFile::write_header(lHeader, pWidth, pHeight, 1, 0);
+	lOut.write(lHeader.data(), lHeader.size());
+
+	//Index placeholder
+	std::string lIndex((size_t)lChunksX * lChunksY * ChunkFile::INDEX_ENTRY_SIZE, '\0');
+	lOut.write(lIndex.data(), lIndex.size());
+	lIndex.clear();
+
+	std::mt19937 lRandom(20);
+	Uint32 lOffset = (Uint32)lOut.tellp();
+	Uint64 lRecords{0};
+	ChunkData lChunk;
+	for(lChunk.y = 0; lChunk.y < lChunksY; lChunk.y++)
+	{
+		for(lChunk.x = 0; lChunk.x < lChunksX; lChunk.x++)
+		{
+			generate_chunk(lRandom, lChunk);
+			if(lChunk.x == lChunksX - 1 && lChunk.y == lChunksY - 1)
+			{
+				lChunk.entities.push_back({'D', pWidth - 2, pHeight - 1, pWidth - 2});
+			}
+
+			//Keep the records inside the map
+			for(auto lIt = lChunk.ground.begin(); lIt != lChunk.ground.end();)
+			{
+				lIt = (lIt->x / LevelMap::TILE_SIZE < pWidth && lIt->y / LevelMap::TILE_SIZE < pHeight) ? lIt + 1 : lChunk.ground.erase(lIt);
+			}
+			for(auto lIt = lChunk.entities.begin(); lIt != lChunk.entities.end();)
+			{
+				lIt = (lIt->x_end < pWidth && lIt->y >= 0 && lIt->y < pHeight) ? lIt + 1 : lChunk.entities.erase(lIt);
+			}
+
+			std::string lContent;
+			ChunkFile::write_chunk(lContent, lChunk);
+			lOut.write(lContent.data(), lContent.size());
+
+			ChunkFile::write_index_entry(lIndex, lContent.empty() ? 0 : lOffset, lChunk.ground.size(), lChunk.entities.size());
+			lOffset += lContent.size();
+			lRecords += lChunk.ground.size() + lChunk.entities.size();
+		}
+	}
+
+	lOut.seekp(lHeader.size());
+	lOut.write(lIndex.data(), lIndex.size());
+	if(!lOut.good())
+	{
+		std::cerr << "Cannot write " << pPath << std::endl;
+		return false;
+	}
+
+	std::cout << pPath << ": " << pWidth << "x" << pHeight << " tiles, " << (Uint64)lChunksX * lChunksY
+		<< " chunks, " << lRecords << " records" << std::endl;
+	return true;
+}
+
+/**
+ * Main program
+ * \brief Compile every given level map
+ **/
+int main(int argc, char* argv[])
+{
+	if(argc < 2)
+	{
+		std::cerr << "Usage: " << argv[0] << " lvl_map..." << std::endl;
+		std::cerr << "       " << argv[0] << " --stress width height lvl_map.chunks" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	if(std::string(argv[1]) == "--stress")
+	{
+		int lWidth = (argc > 2) ? atoi(argv[2]) : 0;
+		int lHeight = (argc > 3) ? atoi(argv[3]) : 0;
+		if(argc != 5 || lWidth < LevelMap::SHEET_WIDTH || lHeight < LevelMap::SHEET_HEIGHT)
+		{
+			std::cerr << "Usage: " << argv[0] << " --stress width height lvl_map.chunks" << std::endl;
+			return EXIT_FAILURE;
+		}
+		return generate_stress(lWidth, lHeight, argv[4]) ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	bool lStatus = true;
+	for(int lIdx = 1; lIdx < argc; lIdx++)
+	{
+		lStatus = compile(argv[lIdx]) && lStatus;
+	}
+
+	return lStatus ? EXIT_SUCCESS : EXIT_FAILURE;
+}